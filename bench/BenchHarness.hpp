@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file BenchHarness.hpp
+ * @brief Cycle-counted micro-benchmark harness for the on-target bench firmware
+ *
+ * Each benchmark times individual iterations with ARM_DWT_CYCCNT and prints
+ * one JSON object per line on USB Serial, so results can be diffed or parsed
+ * between releases:
+ *
+ * @code
+ * {"bench":"usbmidi.send_cc","n":1024,"unit":"cycles","min":41,"avg":44.2,"p99":52,"max":310,"avg_us":0.074}
+ * @endcode
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <Arduino.h>
+
+namespace oc::bench {
+
+constexpr size_t MAX_SAMPLES = 1024;
+
+inline uint32_t cycles() {
+    return ARM_DWT_CYCCNT;
+}
+
+inline float cyclesToUs(float cycleCount) {
+    return cycleCount * 1000000.0f / static_cast<float>(F_CPU_ACTUAL);
+}
+
+/**
+ * @brief Collects per-iteration cycle counts and reports min/avg/p99/max
+ *
+ * Untimed setup between iterations goes outside measure():
+ *
+ * @code
+ * Bench bench("usbmidi.drain_64");
+ * for (size_t i = 0; i < 256; ++i) {
+ *     fill();                                   // not timed
+ *     bench.measure([&] { midi.serviceOutput(UINT32_MAX); });
+ * }
+ * bench.report();
+ * @endcode
+ */
+class Bench {
+public:
+    explicit Bench(const char* name) : name_(name) {}
+
+    template <typename Fn>
+    void measure(Fn&& body) {
+        const uint32_t start = cycles();
+        body();
+        record(cycles() - start);
+    }
+
+    /// Time `iterations` back-to-back calls of body
+    template <typename Fn>
+    Bench& run(size_t iterations, Fn&& body) {
+        for (size_t i = 0; i < iterations; ++i) measure(body);
+        return *this;
+    }
+
+    void record(uint32_t cycleCount) {
+        if (count_ < MAX_SAMPLES) samples_[count_] = cycleCount;
+        ++count_;
+        total_ += cycleCount;
+        min_ = std::min(min_, cycleCount);
+        max_ = std::max(max_, cycleCount);
+    }
+
+    /**
+     * @brief Print the result line
+     * @param bytesPerIteration Non-zero adds an "mbps" throughput field
+     */
+    void report(size_t bytesPerIteration = 0) {
+        if (count_ == 0) {
+            Serial.printf("{\"bench\":\"%s\",\"n\":0}\n", name_);
+            return;
+        }
+
+        const size_t stored = std::min(count_, MAX_SAMPLES);
+        const size_t p99Index = (stored * 99U) / 100U;
+        std::nth_element(samples_.begin(), samples_.begin() + p99Index, samples_.begin() + stored);
+        const uint32_t p99 = samples_[p99Index];
+        const float avg = static_cast<float>(total_) / static_cast<float>(count_);
+        const float avgUs = cyclesToUs(avg);
+
+        Serial.printf("{\"bench\":\"%s\",\"n\":%u,\"unit\":\"cycles\",\"min\":%lu,\"avg\":%.1f,"
+                      "\"p99\":%lu,\"max\":%lu,\"avg_us\":%.3f",
+                      name_, static_cast<unsigned>(count_),
+                      static_cast<unsigned long>(min_), avg,
+                      static_cast<unsigned long>(p99), static_cast<unsigned long>(max_), avgUs);
+        if (bytesPerIteration > 0 && avgUs > 0.0f) {
+            // bytes per microsecond == MB/s
+            Serial.printf(",\"mbps\":%.2f", static_cast<float>(bytesPerIteration) / avgUs);
+        }
+        Serial.printf("}\n");
+    }
+
+    /// Report that a benchmark could not run (missing hardware, init failure)
+    static void skip(const char* name, const char* reason) {
+        Serial.printf("{\"bench\":\"%s\",\"skipped\":\"%s\"}\n", name, reason);
+    }
+
+private:
+    // Shared between benchmarks: they run one at a time
+    static inline std::array<uint32_t, MAX_SAMPLES> samples_{};
+
+    const char* name_;
+    size_t count_ = 0;
+    uint64_t total_ = 0;
+    uint32_t min_ = UINT32_MAX;
+    uint32_t max_ = 0;
+};
+
+}  // namespace oc::bench
@@ -0,0 +1,273 @@
+/**
+ * @file main.cpp
+ * @brief On-target benchmark firmware for the Teensy HAL hot paths
+ *
+ * Build and run with `pio run -e bench -t upload && pio device monitor`.
+ * Results are printed as JSON lines (see BenchHarness.hpp), framed by
+ * {"suite":...} and {"done":true}. Peripherals that are not connected are
+ * reported as skipped. The pins below match our reference surface; adjust
+ * them for other boards.
+ */
+#include <Arduino.h>
+
+#include <array>
+#include <cstring>
+#include <memory>
+
+#include <oc/codec/CobsCodec.hpp>
+#include <oc/hal/teensy/ButtonController.hpp>
+#include <oc/hal/teensy/EEPROMBackend.hpp>
+#include <oc/hal/teensy/EncoderController.hpp>
+#include <oc/hal/teensy/GenericMux.hpp>
+#include <oc/hal/teensy/Ili9341.hpp>
+#include <oc/hal/teensy/LittleFSBackend.hpp>
+#include <oc/hal/teensy/SDCardBackend.hpp>
+#include <oc/hal/teensy/TeensyGpio.hpp>
+#include <oc/hal/teensy/UsbMidi.hpp>
+
+#include "BenchHarness.hpp"
+
+using oc::bench::Bench;
+namespace teensy = oc::hal::teensy;
+namespace embedded = oc::hal::common::embedded;
+
+namespace {
+
+// ── Bench configuration ──
+constexpr uint32_t SERIAL_WAIT_MS = 3000;
+constexpr std::array<uint8_t, 4> MUX_SELECT_PINS = {2, 3, 4, 5};
+constexpr uint8_t MUX_SIGNAL_PIN = 6;
+constexpr std::array<uint8_t, 8> BUTTON_PINS = {30, 31, 32, 33, 34, 35, 36, 37};
+constexpr size_t ENCODER_COUNT = 8;
+constexpr size_t COBS_FRAME_BYTES = 1024;
+constexpr uint32_t STORAGE_BENCH_ADDRESS = 0;
+
+constexpr teensy::Ili9341Config DISPLAY_CONFIG{};
+
+DMAMEM uint16_t displayFramebuffer[DISPLAY_CONFIG.framebufferSize()];
+DMAMEM uint16_t displaySource[DISPLAY_CONFIG.framebufferSize()];
+DMAMEM uint8_t displayDiff1[DISPLAY_CONFIG.recommendedDiffSize()];
+DMAMEM uint8_t displayDiff2[DISPLAY_CONFIG.recommendedDiffSize()];
+
+/// Encoder hardware that never fires: measures EncoderController itself
+class NullEncoderHardware : public oc::interface::IEncoderHardware {
+public:
+    oc::type::Result<void> init() override { return oc::type::Result<void>::ok(); }
+    void setDeltaCallback(oc::interface::EncoderDeltaCallback, void*) override {}
+};
+
+class NullEncoderFactory : public oc::interface::IEncoderHardwareFactory {
+public:
+    std::unique_ptr<oc::interface::IEncoderHardware> create(uint8_t, uint8_t) override {
+        return std::make_unique<NullEncoderHardware>();
+    }
+};
+
+void benchUsbMidi() {
+    static teensy::UsbMidi midi;
+    if (!midi.init()) {
+        Bench::skip("usbmidi", "init failed");
+        return;
+    }
+
+    constexpr size_t BURST = 64;
+
+    Bench sendCC("usbmidi.send_cc");
+    for (size_t burst = 0; burst < 16; ++burst) {
+        for (size_t i = 0; i < BURST; ++i) {
+            sendCC.measure([&] { midi.sendCC(0, static_cast<uint8_t>(i), static_cast<uint8_t>(burst)); });
+        }
+        midi.serviceOutput(UINT32_MAX);
+    }
+    sendCC.report();
+
+    Bench drain("usbmidi.drain_64");
+    for (size_t iteration = 0; iteration < 128; ++iteration) {
+        for (size_t i = 0; i < BURST; ++i) {
+            midi.sendCC(1, static_cast<uint8_t>(i), static_cast<uint8_t>(iteration & 0x7F));
+        }
+        drain.measure([&] { midi.serviceOutput(UINT32_MAX); });
+    }
+    drain.report(BURST * sizeof(uint32_t));
+
+    std::array<uint8_t, 256> sysex{};
+    sysex.front() = 0xF0;
+    sysex.back() = 0xF7;
+    for (size_t i = 1; i + 1 < sysex.size(); ++i) sysex[i] = static_cast<uint8_t>(i & 0x7F);
+
+    Bench sysexDrain("usbmidi.sysex_256");
+    for (size_t iteration = 0; iteration < 64; ++iteration) {
+        sysexDrain.measure([&] {
+            midi.sendSysEx(sysex.data(), sysex.size());
+            midi.serviceOutput(UINT32_MAX);
+        });
+    }
+    sysexDrain.report(sysex.size());
+
+    midi.allNotesOff();
+}
+
+void benchButtons(teensy::TeensyGpio& gpio) {
+    std::array<embedded::ButtonDef, BUTTON_PINS.size()> defs{};
+    for (size_t i = 0; i < defs.size(); ++i) {
+        defs[i].id = static_cast<oc::type::ButtonID>(i + 1);
+        defs[i].pin = {.pin = BUTTON_PINS[i], .source = embedded::GpioPin::Source::MCU};
+    }
+
+    teensy::ButtonController<BUTTON_PINS.size()> buttons(defs, gpio);
+    if (!buttons.init()) {
+        Bench::skip("buttons.update_8", "init failed");
+        return;
+    }
+
+    uint32_t nowMs = millis();
+    Bench bench("buttons.update_8");
+    bench.run(1024, [&] { buttons.update(nowMs++); });
+    bench.report();
+}
+
+void benchMux(teensy::TeensyGpio& gpio) {
+    teensy::GenericMux<MUX_SELECT_PINS.size()> mux(
+        {.selectPins = MUX_SELECT_PINS, .signalPin = MUX_SIGNAL_PIN, .settleTimeUs = 0},
+        gpio);
+    if (!mux.init()) {
+        Bench::skip("mux.scan_16", "init failed");
+        return;
+    }
+
+    volatile uint32_t sink = 0;
+    Bench bench("mux.scan_16");
+    bench.run(1024, [&] {
+        uint32_t bits = 0;
+        for (uint8_t ch = 0; ch < mux.channelCount(); ++ch) {
+            bits |= static_cast<uint32_t>(mux.readDigital(ch)) << ch;
+        }
+        sink = bits;
+    });
+    bench.report();
+    (void)sink;
+}
+
+void benchEncoders() {
+    std::array<teensy::EncoderDef, ENCODER_COUNT> defs{};
+    for (size_t i = 0; i < defs.size(); ++i) {
+        defs[i].id = static_cast<oc::type::EncoderID>(i + 1);
+        defs[i].pinA = static_cast<uint8_t>(2 * i);
+        defs[i].pinB = static_cast<uint8_t>(2 * i + 1);
+    }
+
+    NullEncoderFactory factory;
+    teensy::EncoderController<ENCODER_COUNT> encoders(defs, factory);
+    if (!encoders.init()) {
+        Bench::skip("encoders.update_8", "init failed");
+        return;
+    }
+
+    Bench bench("encoders.update_8");
+    bench.run(1024, [&] { encoders.update(); });
+    bench.report();
+}
+
+void benchDisplay() {
+    static teensy::Ili9341 display(DISPLAY_CONFIG, {
+        .framebuffer = displayFramebuffer,
+        .diff1 = displayDiff1,
+        .diff2 = displayDiff2,
+        .diff1Size = sizeof(displayDiff1),
+        .diff2Size = sizeof(displayDiff2),
+    });
+    if (!display.init()) {
+        Bench::skip("display.flush_full", "init failed");
+        return;
+    }
+
+    const oc::interface::Rect full{0, 0, DISPLAY_CONFIG.width - 1, DISPLAY_CONFIG.height - 1};
+    Bench bench("display.flush_full");
+    for (size_t frame = 0; frame < 64; ++frame) {
+        // Change a band each frame so the diff has real work to do
+        const size_t band = (frame % 8) * (DISPLAY_CONFIG.framebufferSize() / 8);
+        const uint16_t color = static_cast<uint16_t>(frame * 0x0841);
+        std::fill_n(displaySource + band, DISPLAY_CONFIG.framebufferSize() / 8, color);
+        bench.measure([&] { display.flush(displaySource, full); });
+    }
+    display.waitAsyncComplete();
+    bench.report();
+}
+
+void benchCobs() {
+    static std::array<uint8_t, COBS_FRAME_BYTES> frame{};
+    static std::array<uint8_t, oc::codec::cobsMaxEncodedSize(COBS_FRAME_BYTES)> encoded{};
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = static_cast<uint8_t>((i * 31U) & 0xFF);  // Includes zeros
+    }
+
+    size_t encodedLength = 0;
+    Bench encode("cobs.encode_1k");
+    encode.run(256, [&] { encodedLength = oc::codec::cobsEncode(frame.data(), frame.size(), encoded.data()); });
+    encode.report(frame.size());
+
+    static oc::codec::CobsDecoder<COBS_FRAME_BYTES> decoder;
+    volatile size_t decodedLength = 0;
+    Bench decode("cobs.decode_1k");
+    decode.run(256, [&] {
+        for (size_t i = 0; i < encodedLength; ++i) {
+            decoder.feed(encoded[i], [&](const uint8_t*, size_t length) { decodedLength = length; });
+        }
+    });
+    decode.report(frame.size());
+    (void)decodedLength;
+}
+
+void benchStorage(oc::interface::IStorage& storage, const char* name, size_t iterations) {
+    if (!storage.init()) {
+        Bench::skip(name, "init failed");
+        return;
+    }
+
+    std::array<uint8_t, 64> block{};
+    Bench bench(name);
+    for (size_t i = 0; i < iterations; ++i) {
+        block.fill(static_cast<uint8_t>(i));  // Always differs from the last write
+        bench.measure([&] {
+            storage.write(STORAGE_BENCH_ADDRESS, block.data(), block.size());
+            storage.commit();
+        });
+    }
+    bench.report(block.size());
+}
+
+}  // namespace
+
+void setup() {
+    Serial.begin(0);
+    const uint32_t waitStart = millis();
+    while (!Serial && (millis() - waitStart) < SERIAL_WAIT_MS) {
+    }
+
+    // The cycle counter is normally enabled by the core; make sure of it
+    ARM_DEMCR |= ARM_DEMCR_TRCENA;
+    ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+
+    Serial.printf("{\"suite\":\"oc-hal-teensy\",\"f_cpu\":%lu}\n",
+                  static_cast<unsigned long>(F_CPU_ACTUAL));
+
+    teensy::TeensyGpio gpio;
+    benchUsbMidi();
+    benchButtons(gpio);
+    benchMux(gpio);
+    benchEncoders();
+    benchCobs();
+    benchDisplay();
+
+    // Flash writes wear the part: keep iteration counts small
+    teensy::EEPROMBackend eeprom;
+    benchStorage(eeprom, "storage.eeprom_write_64", 16);
+    teensy::LittleFSBackend littleFs(256 * 1024, "/bench.bin");
+    benchStorage(littleFs, "storage.littlefs_write_64", 16);
+    teensy::SDCardBackend sdCard("/bench.bin");
+    benchStorage(sdCard, "storage.sd_write_64", 64);
+
+    Serial.printf("{\"done\":true}\n");
+}
+
+void loop() {}
@@ -28,8 +28,11 @@
 #include <oc/app/OpenControlApp.hpp>
 #include <oc/core/input/InputBindingTrace.hpp>
 #include <oc/hal/teensy/ButtonController.hpp>
+#include <oc/hal/teensy/InterruptButtonController.hpp>
 #include <oc/hal/teensy/EncoderController.hpp>
 #include <oc/hal/teensy/EncoderToolHardware.hpp>
+#include <oc/hal/teensy/LoopScheduler.hpp>
+#include <oc/hal/teensy/ScheduledDrivers.hpp>
 #include <oc/hal/teensy/TeensyGpio.hpp>
 #include <oc/hal/teensy/TeensyOutput.hpp>
 #include <oc/hal/teensy/UsbMidi.hpp>
@@ -38,6 +41,8 @@
 
 #include <Arduino.h>
 
+#include <memory>
+#include <optional>
 #include <utility>
 
 namespace oc::hal::teensy {
@@ -45,6 +50,22 @@ namespace oc::hal::teensy {
 // Alias for common embedded types
 namespace embedded = oc::hal::common::embedded;
 
+/**
+ * @brief Service rates for the drivers registered by AppBuilder::scheduler()
+ *
+ * A period of 0 runs the step on every LoopScheduler::run().
+ */
+struct LoopRates {
+    uint32_t midiOutputPeriodUs = 250;
+    uint32_t midiOutputBudgetUs = 200;
+    uint32_t midiInputPeriodUs = 1000;
+    uint32_t framesPeriodUs = 1000;
+    uint32_t buttonsPeriodUs = 1000;
+    uint32_t encodersPeriodUs = 1000;
+    /// app->update(): contexts, UI and display flush (one 60 Hz refresh)
+    uint32_t appPeriodUs = 16'666;
+};
+
 /**
  * @brief Teensy-optimized application builder
  *
@@ -84,7 +105,7 @@ public:
      * @return Reference to this builder for chaining
      */
     AppBuilder& midi() {
-        builder_.midi(std::make_unique<UsbMidi>());
+        midi_ = std::make_unique<UsbMidi>();
         return *this;
     }
 
@@ -97,7 +118,7 @@ public:
      * @return Reference to this builder for chaining
      */
     AppBuilder& frames() {
-        builder_.frames(std::make_unique<UsbSerial>());
+        serial_ = std::make_unique<UsbSerial>();
         return *this;
     }
 
@@ -110,15 +131,21 @@ public:
      *
      * @tparam N Number of encoders (auto-deduced)
      * @param defs Array of encoder definitions from Config
+     * @param acceleration Velocity curve for all encoders (default: off)
      * @return Reference to this builder for chaining
      *
      * @code
      * .encoders(Config::Encoder::ENCODERS)
+     * .encoders(Config::Encoder::ENCODERS, {.enabled = true, .maxMultiplier = 16})
      * @endcode
      */
     template <size_t N>
-    AppBuilder& encoders(const std::array<embedded::EncoderDef, N>& defs) {
-        builder_.encoders(std::make_unique<EncoderController<N>>(defs, encoderFactory()));
+    AppBuilder& encoders(const std::array<embedded::EncoderDef, N>& defs,
+                         const EncoderAccelConfig& acceleration = {}) {
+        // Hardware stored inline: one allocation for the whole encoder set
+        auto encoders = std::make_unique<EncoderController<N, EncoderToolHardware>>(defs);
+        encoders->setAcceleration(acceleration);
+        encoders_ = std::move(encoders);
         return *this;
     }
 
@@ -129,6 +156,7 @@ public:
     /**
      * @brief Configure buttons from definition array
      *
+     * @tparam Debouncer Debouncer template (default: TimeDebouncer)
      * @tparam N Number of buttons (auto-deduced)
      * @param defs Array of button definitions from Config
      * @param debounceMs Debounce time in milliseconds (default: 5ms)
@@ -137,18 +165,20 @@ public:
      * @code
      * .buttons(Config::Button::BUTTONS)
      * .buttons(Config::Button::BUTTONS, 10)  // Custom debounce
+     * .buttons<VerticalCounterDebouncer>(Config::Button::BUTTONS)
      * @endcode
      */
-    template <size_t N>
+    template <template <size_t> class Debouncer = TimeDebouncer, size_t N>
     AppBuilder& buttons(const std::array<embedded::ButtonDef, N>& defs,
                         uint8_t debounceMs = 5) {
-        builder_.buttons(std::make_unique<ButtonController<N>>(defs, gpio(), nullptr, debounceMs));
+        buttons_ = std::make_unique<ButtonController<N, Debouncer<N>>>(defs, gpio(), nullptr, debounceMs);
         return *this;
     }
 
     /**
      * @brief Configure buttons with multiplexer support
      *
+     * @tparam Debouncer Debouncer template (default: TimeDebouncer)
      * @tparam N Number of buttons (auto-deduced)
      * @param defs Array of button definitions from Config
      * @param mux Multiplexer for reading muxed buttons
@@ -158,13 +188,36 @@ public:
      * @code
      * GenericMux<4> mux(muxConfig, gpio());
      * .buttons(Config::Button::BUTTONS, mux)
+     * .buttons<VerticalCounterDebouncer>(Config::Button::BUTTONS, mux)  // Many buttons
      * @endcode
      */
-    template <size_t N>
+    template <template <size_t> class Debouncer = TimeDebouncer, size_t N>
     AppBuilder& buttons(const std::array<embedded::ButtonDef, N>& defs,
                         interface::IMultiplexer& mux,
                         uint8_t debounceMs = 5) {
-        builder_.buttons(std::make_unique<ButtonController<N>>(defs, gpio(), &mux, debounceMs));
+        buttons_ = std::make_unique<ButtonController<N, Debouncer<N>>>(defs, gpio(), &mux, debounceMs);
+        return *this;
+    }
+
+    /**
+     * @brief Configure MCU buttons read from pin-change interrupts
+     *
+     * Edges are timestamped in the ISR and debounced when update() drains
+     * them, so idle loops do not poll the pins.
+     *
+     * @tparam N Number of buttons (auto-deduced)
+     * @param defs Array of button definitions (MCU pins only)
+     * @param debounceMs Debounce time in milliseconds (default: 5ms)
+     * @return Reference to this builder for chaining
+     *
+     * @code
+     * .interruptButtons(Config::Button::BUTTONS)
+     * @endcode
+     */
+    template <size_t N>
+    AppBuilder& interruptButtons(const std::array<embedded::ButtonDef, N>& defs,
+                                 uint8_t debounceMs = 5) {
+        buttons_ = std::make_unique<InterruptButtonController<N>>(defs, debounceMs);
         return *this;
     }
 
@@ -194,6 +247,42 @@ public:
         return *this;
     }
 
+    // ═══════════════════════════════════════════════════════════════════
+    // SCHEDULING
+    // ═══════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Run the drivers and the app from a LoopScheduler at their own rates
+     *
+     * On build, registers MIDI output drain, MIDI input, frame transport,
+     * buttons and encoders (whichever were configured) in that order, so the
+     * latency-critical steps are checked first, then app->update() at
+     * appPeriodUs. The app is handed ScheduledDrivers wrappers, so its
+     * update() no longer services the drivers: it is left with the contexts,
+     * the UI and the display flush, and a long flush only delays the driver
+     * tasks until it returns. The scheduler replaces app->update() in loop():
+     *
+     * @code
+     * app = oc::hal::teensy::AppBuilder()
+     *     .midi()
+     *     .buttons(Config::BUTTONS)
+     *     .scheduler(scheduler, app);
+     *
+     * void loop() { scheduler.run(); }
+     * @endcode
+     *
+     * @param scheduler Must outlive the app
+     * @param app The optional the built app is assigned to
+     * @param rates Periods and budgets per driver
+     */
+    AppBuilder& scheduler(LoopScheduler& scheduler, std::optional<app::OpenControlApp>& app,
+                          const LoopRates& rates = {}) {
+        scheduler_ = &scheduler;
+        app_ = &app;
+        rates_ = rates;
+        return *this;
+    }
+
     // ═══════════════════════════════════════════════════════════════════
     // BUILD
     // ═══════════════════════════════════════════════════════════════════
@@ -210,12 +299,67 @@ public:
      * @endcode
      */
     operator app::OpenControlApp() {
+        if (scheduler_) {
+            registerTasks_();
+        } else {
+            handOver_();
+        }
         return builder_.build();
     }
 
 private:
     app::AppBuilder builder_;
 
+    // Drivers created by this builder; handed to builder_ on build
+    std::unique_ptr<UsbMidi> midi_;
+    std::unique_ptr<UsbSerial> serial_;
+    std::unique_ptr<interface::IButton> buttons_;
+    std::unique_ptr<interface::IEncoder> encoders_;
+    LoopScheduler* scheduler_ = nullptr;
+    std::optional<app::OpenControlApp>* app_ = nullptr;
+    LoopRates rates_{};
+
+    void handOver_() {
+        if (midi_) builder_.midi(std::move(midi_));
+        if (serial_) builder_.frames(std::move(serial_));
+        if (encoders_) builder_.encoders(std::move(encoders_));
+        if (buttons_) builder_.buttons(std::move(buttons_));
+    }
+
+    void registerTasks_() {
+        // Tasks keep raw pointers: the wrappers own the drivers for the app's lifetime
+        if (midi_) {
+            UsbMidi* midi = midi_.get();
+            builder_.midi(std::make_unique<ScheduledMidi>(std::move(midi_)));
+            scheduler_->add("midi.out", rates_.midiOutputPeriodUs, rates_.midiOutputBudgetUs,
+                            [midi](uint32_t budgetUs) { midi->serviceOutput(budgetUs); });
+            scheduler_->add("midi.in", rates_.midiInputPeriodUs, 0,
+                            [midi](uint32_t) { midi->pollInput(); });
+        }
+        if (serial_) {
+            UsbSerial* serial = serial_.get();
+            builder_.frames(std::make_unique<ScheduledTransport>(std::move(serial_)));
+            scheduler_->add("frames", rates_.framesPeriodUs, 0,
+                            [serial](uint32_t) { serial->update(); });
+        }
+        if (buttons_) {
+            interface::IButton* buttons = buttons_.get();
+            builder_.buttons(std::make_unique<ScheduledButtons>(std::move(buttons_)));
+            scheduler_->add("buttons", rates_.buttonsPeriodUs, 0,
+                            [buttons](uint32_t) { buttons->update(millis()); });
+        }
+        if (encoders_) {
+            interface::IEncoder* encoders = encoders_.get();
+            builder_.encoders(std::make_unique<ScheduledEncoders>(std::move(encoders_)));
+            scheduler_->add("encoders", rates_.encodersPeriodUs, 0,
+                            [encoders](uint32_t) { encoders->update(); });
+        }
+        std::optional<app::OpenControlApp>* app = app_;
+        scheduler_->add("app", rates_.appPeriodUs, 0, [app](uint32_t) {
+            if (app->has_value()) (*app)->update();
+        });
+    }
+
     static uint32_t defaultTimeProvider() {
         return millis();
     }
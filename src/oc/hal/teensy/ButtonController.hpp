@@ -4,6 +4,8 @@
 
 #include <oc/hal/common/embedded/ButtonDef.hpp>
 #include <oc/hal/common/embedded/GpioPin.hpp>
+#include <oc/hal/teensy/ButtonDebouncer.hpp>
+#include <oc/hal/teensy/TeensyGpio.hpp>
 #include <oc/type/Result.hpp>
 #include <oc/interface/IButton.hpp>
 #include <oc/interface/IGpio.hpp>
@@ -11,7 +13,24 @@
 
 namespace oc::hal::teensy {
 
-template <size_t N>
+/**
+ * @brief Debounced button scanner for MCU pins and multiplexer channels
+ *
+ * When constructed with a TeensyGpio, MCU pins are sampled with a
+ * FastPinGroup: one register read per GPIO port per update() instead of one
+ * virtual digitalRead() per button. Any other IGpio (mocks, expanders) keeps
+ * the virtual path; see setFastMcuReads().
+ *
+ * Raw levels are packed 32 per word and handed to the Debouncer, which
+ * reports accepted edges only. TimeDebouncer keeps the classic per-button
+ * lockout; VerticalCounterDebouncer debounces whole words at once for large
+ * (e.g. muxed) button sets, and update() skips the pin and mux scan entirely
+ * until it wants its next sample.
+ *
+ * @tparam N Number of buttons
+ * @tparam Debouncer TimeDebouncer<N> or VerticalCounterDebouncer<N>
+ */
+template <size_t N, typename Debouncer = TimeDebouncer<N>>
 class ButtonController : public interface::IButton {
 public:
     using ButtonDef = common::embedded::ButtonDef;
@@ -21,10 +40,16 @@ public:
         interface::IGpio& gpio,
         interface::IMultiplexer* mux = nullptr,
         uint8_t debounceMs = 5)
-        : buttons_(buttons), gpio_(gpio), mux_(mux), debounce_ms_(debounceMs) {
-        states_.fill(false);
-        last_change_.fill(0);
-    }
+        : buttons_(buttons), gpio_(gpio), mux_(mux), debouncer_(debounceMs) {}
+
+    /// TeensyGpio drives the MCU pins directly: register reads are enabled
+    ButtonController(
+        const std::array<ButtonDef, N>& buttons,
+        TeensyGpio& gpio,
+        interface::IMultiplexer* mux = nullptr,
+        uint8_t debounceMs = 5)
+        : buttons_(buttons), gpio_(gpio), mux_(mux), debouncer_(debounceMs),
+          fast_requested_(true) {}
 
     oc::type::Result<void> init() override {
         for (const auto& btn : buttons_) {
@@ -32,46 +57,72 @@ public:
                 gpio_.pinMode(btn.pin.pin, interface::PinMode::PIN_INPUT_PULLUP);
             }
         }
+        fast_mcu_ = fast_requested_ && buildFastPins_();
         initialized_ = true;
         return oc::type::Result<void>::ok();
     }
 
     void update(uint32_t currentTimeMs) override {
         if (!initialized_) return;
+        // Muxed reads block on select + settle: only scan when the sample is used
+        if (!debouncer_.wantsSample(currentTimeMs)) return;
+
+        if (fast_mcu_) fast_pins_.sample();
 
+        ButtonWords<N> raw{};
         for (size_t i = 0; i < N; ++i) {
-            bool raw = readPin(buttons_[i]);
-            bool pressed = buttons_[i].activeLow ? !raw : raw;
-
-            if (pressed != states_[i]) {
-                if (currentTimeMs - last_change_[i] >= debounce_ms_) {
-                    states_[i] = pressed;
-                    last_change_[i] = currentTimeMs;
-
-                    if (callback_) {
-                        callback_(
-                            buttons_[i].id,
-                            pressed ? oc::type::ButtonEvent::PRESSED
-                                    : oc::type::ButtonEvent::RELEASED);
-                    }
-                }
-            }
+            const bool level = readPin(i);
+            const bool pressed = buttons_[i].activeLow ? !level : level;
+            raw[i >> 5] |= static_cast<uint32_t>(pressed) << (i & 31);
         }
+
+        debouncer_.update(raw, currentTimeMs, [this](size_t i, bool pressed) {
+            if (callback_) {
+                callback_(
+                    buttons_[i].id,
+                    pressed ? oc::type::ButtonEvent::PRESSED
+                            : oc::type::ButtonEvent::RELEASED);
+            }
+        });
     }
 
     bool isPressed(oc::type::ButtonID id) const override {
         for (size_t i = 0; i < N; ++i) {
-            if (buttons_[i].id == id) return states_[i];
+            if (buttons_[i].id == id) return debouncer_.pressed(i);
         }
         return false;
     }
 
     void setCallback(oc::type::ButtonCallback cb) override { callback_ = cb; }
 
+    /**
+     * @brief Force the register-level MCU read path on or off
+     *
+     * Only enable it when the IGpio passed in drives the MCU pins directly.
+     * Applied at init(), or immediately when already initialized.
+     */
+    void setFastMcuReads(bool enabled) {
+        fast_requested_ = enabled;
+        fast_mcu_ = enabled && initialized_ && buildFastPins_();
+    }
+
+    /// Whether update() reads MCU pins from registers (false before init())
+    bool fastMcuReads() const { return fast_mcu_; }
+
 private:
-    bool readPin(const ButtonDef& btn) {
+    bool buildFastPins_() {
+        fast_pins_ = FastPinGroup<N>();
+        for (size_t i = 0; i < N; ++i) {
+            if (buttons_[i].pin.source != common::embedded::GpioPin::Source::MCU) continue;
+            if (!fast_pins_.set(i, buttons_[i].pin.pin)) return false;
+        }
+        return true;
+    }
+
+    bool readPin(size_t index) {
+        const ButtonDef& btn = buttons_[index];
         if (btn.pin.source == common::embedded::GpioPin::Source::MCU) {
-            return gpio_.digitalRead(btn.pin.pin);
+            return fast_mcu_ ? fast_pins_.read(index) : gpio_.digitalRead(btn.pin.pin);
         } else {
             if (mux_) {
                 return mux_->readDigital(btn.pin.pin);
@@ -83,11 +134,11 @@ private:
     std::array<ButtonDef, N> buttons_;
     interface::IGpio& gpio_;
     interface::IMultiplexer* mux_;
-    uint8_t debounce_ms_;
-
-    std::array<bool, N> states_;
-    std::array<uint32_t, N> last_change_;
+    Debouncer debouncer_;
     oc::type::ButtonCallback callback_;
+    FastPinGroup<N> fast_pins_;
+    bool fast_requested_ = false;
+    bool fast_mcu_ = false;
     bool initialized_ = false;
 };
 
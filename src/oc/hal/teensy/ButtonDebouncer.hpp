@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Raw or debounced button levels packed 32 per word (bit i = button i)
+ */
+template <size_t N>
+using ButtonWords = std::array<uint32_t, (N + 31) / 32>;
+
+/**
+ * @brief Per-button time lockout debouncer (ButtonController default)
+ *
+ * A level change is accepted immediately unless the previous accepted change
+ * on that button is less than `debounceMs` old. Costs one timestamp per
+ * button and a loop over every button per update.
+ */
+template <size_t N>
+class TimeDebouncer {
+public:
+    explicit TimeDebouncer(uint8_t debounceMs) : debounce_ms_(debounceMs) {
+        states_.fill(false);
+        last_change_.fill(0);
+    }
+
+    /// Every scan is used
+    bool wantsSample(uint32_t) const { return true; }
+
+    /// Feed one scan; onEdge(index, pressed) is called for each accepted change
+    template <typename OnEdge>
+    void update(const ButtonWords<N>& raw, uint32_t nowMs, OnEdge&& onEdge) {
+        for (size_t i = 0; i < N; ++i) {
+            const bool pressed = (raw[i >> 5] >> (i & 31)) & 0x01;
+            if (pressed != states_[i] && nowMs - last_change_[i] >= debounce_ms_) {
+                states_[i] = pressed;
+                last_change_[i] = nowMs;
+                onEdge(i, pressed);
+            }
+        }
+    }
+
+    bool pressed(size_t index) const { return states_[index]; }
+
+private:
+    uint8_t debounce_ms_;
+    std::array<bool, N> states_;
+    std::array<uint32_t, N> last_change_;
+};
+
+/**
+ * @brief Bit-sliced vertical-counter debouncer
+ *
+ * Each button owns one bit in each of three words (state and a 2-bit
+ * counter), so 32 buttons are debounced with a handful of logic operations
+ * and RAM is 12 bytes per 32 buttons. A change is accepted after four
+ * consecutive samples disagree with the debounced state; samples are taken
+ * every debounceMs / 4 (at least every millisecond), so the delay
+ * approximates debounceMs. Edges come from the XOR of old and new state and
+ * are walked with count-trailing-zeros, so quiet words cost nothing.
+ */
+template <size_t N>
+class VerticalCounterDebouncer {
+public:
+    static constexpr size_t WORDS = (N + 31) / 32;
+    static constexpr uint8_t SAMPLES = 4;
+
+    explicit VerticalCounterDebouncer(uint8_t debounceMs)
+        : sample_ms_(debounceMs >= SAMPLES ? debounceMs / SAMPLES : 1) {
+        state_.fill(0);
+        count0_.fill(~0u);
+        count1_.fill(~0u);
+    }
+
+    /// False until the next sample is due: callers can skip the scan
+    bool wantsSample(uint32_t nowMs) const {
+        return !sampled_ || nowMs - last_sample_ms_ >= sample_ms_;
+    }
+
+    /// Feed one scan; onEdge(index, pressed) is called for each accepted change
+    template <typename OnEdge>
+    void update(const ButtonWords<N>& raw, uint32_t nowMs, OnEdge&& onEdge) {
+        if (!wantsSample(nowMs)) return;
+        sampled_ = true;
+        last_sample_ms_ = nowMs;
+
+        for (size_t w = 0; w < WORDS; ++w) {
+            // Bits that disagree count down; agreeing bits reset to 3
+            uint32_t delta = state_[w] ^ raw[w];
+            count0_[w] = ~(count0_[w] & delta);
+            count1_[w] = count0_[w] ^ (count1_[w] & delta);
+            delta &= count0_[w] & count1_[w];  // Rolled over: accept
+            if (delta == 0) continue;
+
+            state_[w] ^= delta;
+            while (delta != 0) {
+                const uint32_t bit = static_cast<uint32_t>(__builtin_ctz(delta));
+                onEdge(w * 32 + bit, ((state_[w] >> bit) & 0x01) != 0);
+                delta &= delta - 1;
+            }
+        }
+    }
+
+    bool pressed(size_t index) const { return (state_[index >> 5] >> (index & 31)) & 0x01; }
+
+    /// Debounced levels, one bit per button
+    const ButtonWords<N>& states() const { return state_; }
+
+private:
+    ButtonWords<N> state_;
+    ButtonWords<N> count0_;
+    ButtonWords<N> count1_;
+    uint32_t last_sample_ms_ = 0;
+    uint8_t sample_ms_;
+    bool sampled_ = false;
+};
+
+}  // namespace oc::hal::teensy
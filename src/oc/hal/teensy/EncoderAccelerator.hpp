@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Velocity curve for EncoderAccelerator
+ *
+ * Intervals between hardware deltas at or above `slowUs` pass through
+ * unchanged; at or below `fastUs` they are multiplied by `maxMultiplier`.
+ * In between, the multiplier follows the selected curve.
+ */
+struct EncoderAccelConfig {
+    enum class Curve : uint8_t {
+        LINEAR,     ///< Multiplier grows linearly with speed
+        QUADRATIC,  ///< Gentle at moderate speed, steep when spinning
+    };
+
+    bool enabled = false;
+    uint32_t slowUs = 40000;     ///< Interval with no acceleration (clamped below the ~7 s cycle wrap)
+    uint32_t fastUs = 2000;      ///< Interval reaching maxMultiplier
+    uint16_t maxMultiplier = 8;  ///< Upper bound of the multiplier
+    Curve curve = Curve::QUADRATIC;
+};
+
+/**
+ * @brief Per-encoder, ISR-safe velocity acceleration
+ *
+ * apply() timestamps each hardware delta with the cycle counter and scales it
+ * by a Q8 fixed-point multiplier derived from the interval since the previous
+ * delta. Only integer math in the ISR path: thresholds are converted to
+ * cycles in configure(), and the fractional part of each scaled delta is
+ * carried to the next one (and dropped on direction change), so slow
+ * movement stays one-to-one while fast spins cover large ranges quickly.
+ *
+ * @note Intervals longer than the ~7 s cycle-counter wrap may be misread as
+ *       fast; the first delta after such a pause can be over-scaled once.
+ */
+class EncoderAccelerator {
+public:
+    static constexpr uint32_t Q8_ONE = 256;
+
+    /// Thread context; an ISR racing the update sees at most one mixed curve
+    void configure(const EncoderAccelConfig& config) {
+        static constexpr uint64_t MAX_INTERVAL_CYCLES = 0xF0000000u;  // Below the cycle-counter wrap
+        const uint64_t cyclesPerUs = F_CPU_ACTUAL / 1000000;
+        uint64_t slow = static_cast<uint64_t>(config.slowUs) * cyclesPerUs;
+        uint64_t fast = static_cast<uint64_t>(config.fastUs) * cyclesPerUs;
+        if (slow > MAX_INTERVAL_CYCLES) slow = MAX_INTERVAL_CYCLES;
+        if (fast > slow) fast = slow;
+        const uint32_t span = static_cast<uint32_t>(slow - fast);
+
+        slow_cycles_ = static_cast<uint32_t>(slow);
+        fast_cycles_ = static_cast<uint32_t>(fast);
+        span_q8_ = span >= Q8_ONE ? span / Q8_ONE : 1;
+        max_gain_q8_ = config.maxMultiplier > 1 ? (config.maxMultiplier - 1U) * Q8_ONE : 0;
+        quadratic_ = config.curve == EncoderAccelConfig::Curve::QUADRATIC;
+        enabled_ = config.enabled && max_gain_q8_ > 0;
+        residue_q8_ = 0;
+    }
+
+    bool enabled() const { return enabled_; }
+
+    /// ISR context: scale one hardware delta
+    int32_t apply(int32_t delta, uint32_t nowCycles) {
+        if (!enabled_ || delta == 0) return delta;
+
+        const uint32_t interval = nowCycles - last_cycles_;
+        last_cycles_ = nowCycles;
+
+        uint32_t multiplier = Q8_ONE;
+        if (primed_ && interval < slow_cycles_) {
+            uint32_t speed = Q8_ONE;  // 0..256: slow..fast
+            if (interval > fast_cycles_) {
+                speed = (slow_cycles_ - interval) / span_q8_;
+                if (speed > Q8_ONE) speed = Q8_ONE;
+            }
+            if (quadratic_) speed = (speed * speed) >> 8;
+            multiplier += (max_gain_q8_ * speed) >> 8;
+        }
+        primed_ = true;
+
+        // Reversal: do not let leftover fraction from the other way eat ticks
+        if ((residue_q8_ < 0) != (delta < 0)) residue_q8_ = 0;
+
+        const int32_t scaled = delta * static_cast<int32_t>(multiplier) + residue_q8_;
+        const int32_t out = scaled / static_cast<int32_t>(Q8_ONE);  // Truncates toward zero
+        residue_q8_ = scaled - out * static_cast<int32_t>(Q8_ONE);
+        return out;
+    }
+
+private:
+    uint32_t slow_cycles_ = 0;
+    uint32_t fast_cycles_ = 0;
+    uint32_t span_q8_ = 1;
+    uint32_t max_gain_q8_ = 0;
+    uint32_t last_cycles_ = 0;
+    int32_t residue_q8_ = 0;
+    bool quadratic_ = true;
+    bool enabled_ = false;
+    bool primed_ = false;
+};
+
+}  // namespace oc::hal::teensy
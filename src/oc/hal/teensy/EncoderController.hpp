@@ -1,9 +1,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include <oc/hal/common/embedded/EncoderDef.hpp>
+#include <oc/hal/teensy/EncoderAccelerator.hpp>
+#include <oc/hal/teensy/HighResolutionClock.hpp>
+#include <oc/hal/teensy/IdIndexTable.hpp>
 #include <oc/type/Result.hpp>
 #include <oc/core/input/EncoderLogic.hpp>
 #include <oc/interface/IEncoder.hpp>
@@ -22,36 +28,68 @@ struct EncoderContext;
 /**
  * @brief Teensy encoder controller using hardware abstraction
  *
+ * Encoder logic objects are stored inline and contiguously (no per-encoder
+ * heap allocation), and IDs resolve to indices through an IdIndexTable, so
+ * setters and lookups are constant-time.
+ *
+ * The hardware ISR only adds its raw delta to a per-encoder atomic and sets
+ * the encoder's bit in a dirty mask. update() walks the dirty bits (CTZ) and
+ * runs the floating-point EncoderLogic in thread context, so an idle update()
+ * is one load per 32 encoders.
+ *
+ * setAcceleration() enables an EncoderAccelerator stage in the ISR that
+ * scales each hardware delta by the turning speed (cycle-counter intervals,
+ * fixed-point math), so fast spins cover a wide range in fewer events.
+ *
+ * With the default `Hardware = void`, hardware instances come from an
+ * IEncoderHardwareFactory (one heap allocation each). Naming a concrete
+ * hardware type stores those inline too:
+ *
+ * @code
+ * EncoderController<N> encoders(defs, encoderFactory());       // Factory-created
+ * EncoderController<N, EncoderToolHardware> encoders(defs);    // Fully inline
+ * @endcode
+ *
  * @tparam N Number of encoders to manage
+ * @tparam Hardware Concrete IEncoderHardware constructible from (pinA, pinB), or void
  */
-template <size_t N>
+template <size_t N, typename Hardware = void>
 class EncoderController : public interface::IEncoder {
+    static constexpr bool INLINE_HARDWARE = !std::is_void_v<Hardware>;
+
 public:
+    /// Factory-created hardware
+    template <typename H = Hardware, std::enable_if_t<std::is_void_v<H>, int> = 0>
     EncoderController(
         const std::array<EncoderDef, N>& defs,
         interface::IEncoderHardwareFactory& factory)
-        : defs_(defs), factory_(factory) {
-        for (size_t i = 0; i < N; ++i) {
-            core::input::EncoderConfig cfg{
-                .id = defs[i].id,
-                .ppr = defs[i].ppr,
-                .rangeAngle = defs[i].rangeAngle,
-                .ticksPerEvent = defs[i].ticksPerEvent,
-                .invertDirection = defs[i].invertDirection
-            };
-            encoders_logic_[i] = std::make_unique<core::input::EncoderLogic>(cfg);
-            contexts_[i] = {this, i};
-        }
+        : defs_(defs), factory_(&factory),
+          encoders_logic_(makeLogic_(defs, std::make_index_sequence<N>{})),
+          index_(makeIds_(defs, std::make_index_sequence<N>{})) {
+        initContexts_();
+    }
+
+    /// Inline hardware of type Hardware
+    template <typename H = Hardware, std::enable_if_t<!std::is_void_v<H>, int> = 0>
+    explicit EncoderController(const std::array<EncoderDef, N>& defs)
+        : defs_(defs),
+          encoders_hw_(makeHardware_(defs, std::make_index_sequence<N>{})),
+          encoders_logic_(makeLogic_(defs, std::make_index_sequence<N>{})),
+          index_(makeIds_(defs, std::make_index_sequence<N>{})) {
+        initContexts_();
     }
 
     oc::type::Result<void> init() override {
         if (initialized_) return oc::type::Result<void>::ok();
 
         for (size_t i = 0; i < N; ++i) {
-            const auto& def = defs_[i];
-            encoders_hw_[i] = factory_.create(def.pinA, def.pinB);
-            encoders_hw_[i]->setDeltaCallback(onDelta, &contexts_[i]);
-            auto result = encoders_hw_[i]->init();
+            if constexpr (!INLINE_HARDWARE) {
+                const auto& def = defs_[i];
+                encoders_hw_[i] = factory_->create(def.pinA, def.pinB);
+            }
+            interface::IEncoderHardware& hw = hardware_(i);
+            hw.setDeltaCallback(onDelta, &contexts_[i]);
+            auto result = hw.init();
             if (!result) {
                 return result;
             }
@@ -62,84 +100,188 @@ public:
 
     void update() override {
         if (!initialized_) return;
-        for (size_t i = 0; i < N; ++i) {
-            auto pending = encoders_logic_[i]->flush();
-            if (pending.has_value() && callback_) {
-                callback_(defs_[i].id, pending.value());
+        for (size_t w = 0; w < DIRTY_WORDS; ++w) {
+            if (dirty_[w].load(std::memory_order_relaxed) == 0) continue;
+            uint32_t bits = dirty_[w].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                const size_t i = w * 32 + static_cast<size_t>(__builtin_ctz(bits));
+                bits &= bits - 1;
+
+                const int32_t delta = pending_delta_[i].exchange(0, std::memory_order_relaxed);
+                auto& logic = encoders_logic_[i];
+                if (delta != 0) logic.processDelta(delta);
+
+                auto pending = logic.flush();
+                if (pending.has_value() && callback_) {
+                    callback_(defs_[i].id, pending.value());
+                }
             }
         }
     }
 
     float getPosition(oc::type::EncoderID id) const override {
         int idx = findIndex(id);
-        return idx >= 0 ? encoders_logic_[idx]->getLastValue() : 0.0f;
+        return idx >= 0 ? encoders_logic_[idx].getLastValue() : 0.0f;
     }
 
     void setPosition(oc::type::EncoderID id, float value) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setPosition(value);
+        if (idx >= 0) {
+            encoders_logic_[idx].setPosition(value);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setMode(oc::type::EncoderID id, interface::EncoderMode mode) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setMode(mode);
+        if (idx >= 0) {
+            encoders_logic_[idx].setMode(mode);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setBounds(oc::type::EncoderID id, float min, float max) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setBounds(min, max);
+        if (idx >= 0) {
+            encoders_logic_[idx].setBounds(min, max);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setDiscreteSteps(oc::type::EncoderID id, uint8_t steps) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setDiscreteSteps(steps);
+        if (idx >= 0) {
+            encoders_logic_[idx].setDiscreteSteps(steps);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setDiscreteTicksPerStep(oc::type::EncoderID id, uint16_t ticksPerStep) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setDiscreteTicksPerStep(ticksPerStep);
+        if (idx >= 0) {
+            encoders_logic_[idx].setDiscreteTicksPerStep(ticksPerStep);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setNormalizedTurns(oc::type::EncoderID id, float turns) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setNormalizedTurns(turns);
+        if (idx >= 0) {
+            encoders_logic_[idx].setNormalizedTurns(turns);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setContinuous(oc::type::EncoderID id) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setContinuous();
+        if (idx >= 0) {
+            encoders_logic_[idx].setContinuous();
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setDelta(oc::type::EncoderID id, float delta) override {
         int idx = findIndex(id);
-        if (idx >= 0) encoders_logic_[idx]->setDelta(delta);
+        if (idx >= 0) {
+            encoders_logic_[idx].setDelta(delta);
+            markDirty_(static_cast<size_t>(idx));  // Flush any value the setter left pending
+        }
     }
 
     void setCallback(oc::type::EncoderCallback cb) override { callback_ = cb; }
 
+    /// Apply one velocity curve to every encoder (disabled by default)
+    void setAcceleration(const EncoderAccelConfig& config) {
+        for (auto& accel : accel_) accel.configure(config);
+    }
+
+    /// Per-encoder velocity curve (EncoderDef has no acceleration fields)
+    void setAcceleration(oc::type::EncoderID id, const EncoderAccelConfig& config) {
+        int idx = findIndex(id);
+        if (idx >= 0) accel_[idx].configure(config);
+    }
+
 private:
     struct Context {
         EncoderController* controller;
         size_t index;
     };
 
+    static constexpr size_t DIRTY_WORDS = (N + 31) / 32;
+
+    using HardwareStorage = std::conditional_t<INLINE_HARDWARE,
+        std::array<std::conditional_t<INLINE_HARDWARE, Hardware, char>, N>,
+        std::array<std::unique_ptr<interface::IEncoderHardware>, N>>;
+
+    static core::input::EncoderConfig configFor_(const EncoderDef& def) {
+        return core::input::EncoderConfig{
+            .id = def.id,
+            .ppr = def.ppr,
+            .rangeAngle = def.rangeAngle,
+            .ticksPerEvent = def.ticksPerEvent,
+            .invertDirection = def.invertDirection
+        };
+    }
+
+    // Built in place (guaranteed elision), so EncoderLogic needs no copy/move
+    template <size_t... I>
+    static std::array<core::input::EncoderLogic, N> makeLogic_(
+        const std::array<EncoderDef, N>& defs, std::index_sequence<I...>) {
+        return {{core::input::EncoderLogic(configFor_(defs[I]))...}};
+    }
+
+    template <size_t... I>
+    static HardwareStorage makeHardware_(const std::array<EncoderDef, N>& defs, std::index_sequence<I...>) {
+        return {{Hardware(defs[I].pinA, defs[I].pinB)...}};
+    }
+
+    template <size_t... I>
+    static IdIndexTable<oc::type::EncoderID, N> makeIds_(
+        const std::array<EncoderDef, N>& defs, std::index_sequence<I...>) {
+        return IdIndexTable<oc::type::EncoderID, N>(std::array<oc::type::EncoderID, N>{{defs[I].id...}});
+    }
+
+    void initContexts_() {
+        for (size_t i = 0; i < N; ++i) {
+            contexts_[i] = {this, i};
+        }
+    }
+
+    interface::IEncoderHardware& hardware_(size_t i) {
+        if constexpr (INLINE_HARDWARE) {
+            return encoders_hw_[i];
+        } else {
+            return *encoders_hw_[i];
+        }
+    }
+
+    /// ISR context: accumulate only, the logic runs in update()
     static void onDelta(void* ctx, int32_t delta) {
         auto* c = static_cast<Context*>(ctx);
-        c->controller->encoders_logic_[c->index]->processDelta(delta);
+        EncoderController* self = c->controller;
+        delta = self->accel_[c->index].apply(delta, HighResolutionClock::cycles());
+        if (delta == 0) return;  // Fraction carried by the accelerator
+        self->pending_delta_[c->index].fetch_add(delta, std::memory_order_relaxed);
+        self->markDirty_(c->index);
+    }
+
+    void markDirty_(size_t index) {
+        dirty_[index >> 5].fetch_or(1u << (index & 31), std::memory_order_release);
     }
 
     int findIndex(oc::type::EncoderID id) const {
-        for (size_t i = 0; i < N; ++i) {
-            if (defs_[i].id == id) return static_cast<int>(i);
-        }
-        return -1;
+        return index_.find(id);
     }
 
     std::array<EncoderDef, N> defs_;
-    interface::IEncoderHardwareFactory& factory_;
+    interface::IEncoderHardwareFactory* factory_ = nullptr;  // Factory mode only
     std::array<Context, N> contexts_;
-    std::array<std::unique_ptr<interface::IEncoderHardware>, N> encoders_hw_;
-    std::array<std::unique_ptr<core::input::EncoderLogic>, N> encoders_logic_;
+    HardwareStorage encoders_hw_;
+    std::array<core::input::EncoderLogic, N> encoders_logic_;
+    std::array<std::atomic<int32_t>, N> pending_delta_{};  // Raw ISR deltas not yet processed
+    std::array<std::atomic<uint32_t>, DIRTY_WORDS> dirty_{};
+    std::array<EncoderAccelerator, N> accel_{};  // Touched by the ISR only in apply()
+    IdIndexTable<oc::type::EncoderID, N> index_;
     oc::type::EncoderCallback callback_;
     bool initialized_ = false;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <memory>
 
 #include <Arduino.h>
 
@@ -13,6 +15,18 @@ namespace oc::hal::teensy {
 /**
  * @brief Generic multiplexer driver for CD74HC40xx series
  *
+ * By default every read selects its channel and busy-waits `settleTimeUs`.
+ * With `scanPeriodUs` set, init() starts an IntervalTimer that sweeps all
+ * channels in the background instead: each tick samples the current channel
+ * and moves to the next one in Gray-code order, so exactly one select pin
+ * changes and it is driven with a single GPIO toggle-register write. Every
+ * channel then settles for one full timer period, and readDigital() /
+ * readAnalog() return the latest sweep without blocking.
+ *
+ * @code
+ * CD74HC4067 mux({{2, 3, 4, 5}, 6, 20, true, 25}, gpio());  // 25 µs per channel
+ * @endcode
+ *
  * @tparam NumPins Number of select pins (1-4)
  */
 template <uint8_t NumPins>
@@ -25,6 +39,8 @@ public:
         uint8_t signalPin;
         uint16_t settleTimeUs = 20;
         bool signalPullup = true;
+        uint32_t scanPeriodUs = 0;  ///< Background sweep period per channel (0 = blocking select)
+        bool scanAnalog = false;    ///< Also sample analogRead() in the sweep (adds ADC time per tick)
     };
 
     GenericMux(const Config& cfg, interface::IGpio& gpio)
@@ -44,13 +60,15 @@ public:
                                             : interface::PinMode::PIN_INPUT);
         current_channel_ = 0;
         initialized_ = true;
+
+        if (config_.scanPeriodUs > 0) return startScan_();
         return oc::type::Result<void>::ok();
     }
 
     uint8_t channelCount() const override { return 1 << NumPins; }
 
     void select(uint8_t channel) override {
-        if (!initialized_ || channel >= channelCount()) return;
+        if (!initialized_ || scanner_ || channel >= channelCount()) return;
         if (channel == current_channel_) return;
 
         for (uint8_t i = 0; i < NumPins; ++i) {
@@ -61,22 +79,112 @@ public:
     }
 
     bool readDigital(uint8_t channel) override {
+        if (scanner_) {
+            return channel < CHANNELS && ((scanner_->digital.load(std::memory_order_relaxed) >> channel) & 0x01);
+        }
         select(channel);
         return gpio_->digitalRead(config_.signalPin);
     }
 
+    /// In scan mode, returns the last swept value (0 unless `scanAnalog`)
     uint16_t readAnalog(uint8_t channel) override {
+        if (scanner_) {
+            return channel < CHANNELS ? scanner_->analog[channel] : 0;
+        }
         select(channel);
         return gpio_->analogRead(config_.signalPin);
     }
 
     bool supportsAnalog() const override { return true; }
 
+    /// True while the background sweep is running
+    bool scanning() const { return scanner_ != nullptr; }
+
+    /// Completed background sweeps (0 in blocking mode)
+    uint32_t sweepCount() const {
+        return scanner_ ? scanner_->sweeps.load(std::memory_order_relaxed) : 0;
+    }
+
 private:
+    static constexpr uint8_t CHANNELS = 1 << NumPins;
+
+    /**
+     * @brief Timer-driven sweep state
+     *
+     * Heap-allocated so the ISR keeps a stable pointer while GenericMux moves.
+     */
+    struct Scanner {
+        IntervalTimer timer;
+        std::array<volatile uint32_t*, NumPins> toggleReg{};
+        std::array<uint32_t, NumPins> toggleMask{};
+        volatile uint32_t* inputReg = nullptr;
+        uint32_t inputMask = 0;
+        uint8_t signalPin = 0;
+        bool sampleAnalog = false;
+
+        uint8_t step = 0;      // Position in the Gray-code sequence
+        uint8_t channel = 0;   // Channel currently on the select pins
+        uint32_t working = 0;  // Bits of the sweep in progress
+
+        std::atomic<uint32_t> digital{0};
+        std::atomic<uint32_t> sweeps{0};
+        std::array<volatile uint16_t, CHANNELS> analog{};
+
+        void tick() {
+            if (*inputReg & inputMask) working |= (1u << channel);
+            if (sampleAnalog) analog[channel] = ::analogRead(signalPin);
+
+            // Gray code: going from step k to k+1 flips bit ctz(k+1), and
+            // the wrap back to 0 flips the top bit
+            ++step;
+            uint8_t bit = NumPins - 1;
+            if (step == CHANNELS) {
+                step = 0;
+                digital.store(working, std::memory_order_relaxed);
+                sweeps.fetch_add(1, std::memory_order_relaxed);
+                working = 0;
+            } else {
+                bit = static_cast<uint8_t>(__builtin_ctz(step));
+            }
+            *toggleReg[bit] = toggleMask[bit];
+            channel ^= static_cast<uint8_t>(1u << bit);
+        }
+    };
+
+    oc::type::Result<void> startScan_() {
+        auto scanner = std::make_unique<Scanner>();
+        for (uint8_t i = 0; i < NumPins; ++i) {
+            scanner->toggleReg[i] = portToggleRegister(config_.selectPins[i]);
+            scanner->toggleMask[i] = digitalPinToBitMask(config_.selectPins[i]);
+        }
+        scanner->inputReg = portInputRegister(config_.signalPin);
+        scanner->inputMask = digitalPinToBitMask(config_.signalPin);
+        scanner->signalPin = config_.signalPin;
+        scanner->sampleAnalog = config_.scanAnalog;
+
+        // Seed the results with one blocking sweep so reads are valid at once
+        uint32_t seed = 0;
+        for (uint8_t ch = 0; ch < CHANNELS; ++ch) {
+            select(ch);
+            if (gpio_->digitalRead(config_.signalPin)) seed |= (1u << ch);
+            if (config_.scanAnalog) scanner->analog[ch] = gpio_->analogRead(config_.signalPin);
+        }
+        select(0);
+        scanner->digital.store(seed, std::memory_order_relaxed);
+
+        Scanner* isr = scanner.get();
+        if (!scanner->timer.begin([isr] { isr->tick(); }, config_.scanPeriodUs)) {
+            return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "No free IntervalTimer"});
+        }
+        scanner_ = std::move(scanner);
+        return oc::type::Result<void>::ok();
+    }
+
     Config config_;
     interface::IGpio* gpio_ = nullptr;  // Pointer enables move semantics
     uint8_t current_channel_ = 0;
     bool initialized_ = false;
+    std::unique_ptr<Scanner> scanner_;  // Set in scan mode only
 };
 
 using CD74HC4067 = GenericMux<4>;
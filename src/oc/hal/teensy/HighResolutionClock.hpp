@@ -17,6 +17,15 @@ class HighResolutionClock {
 public:
     uint64_t micros64();
 
+    /// Raw cycle counter; stateless, so safe from any context (wraps every ~7 s)
+    static uint32_t cycles() { return ARM_DWT_CYCCNT; }
+
+    /// Convert a cycle count (e.g. a difference of cycles()) to microseconds
+    static uint32_t cyclesToMicros(uint32_t cycleCount) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(cycleCount) * 1000000ULL) /
+                                     static_cast<uint64_t>(F_CPU_ACTUAL));
+    }
+
 private:
     uint32_t last_cycles_ = 0;
     uint64_t cycle_wrap_base_ = 0;
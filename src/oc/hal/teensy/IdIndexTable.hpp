@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Constant-time ID -> array index map for fixed control sets
+ *
+ * Open addressing over a power-of-two table at least twice the entry count,
+ * so lookups resolve in one or two probes. Dense ID ranges (base, base+1, ...)
+ * are detected and resolved with a subtraction. The constructor is constexpr:
+ * built from a constexpr ID list, the table is computed at compile time.
+ *
+ * @code
+ * static constexpr IdIndexTable<uint16_t, 4> table({10, 11, 12, 13});
+ * static_assert(table.find(12) == 2);
+ * @endcode
+ *
+ * @tparam Id Unsigned integer ID type
+ * @tparam N Number of entries
+ */
+template <typename Id, size_t N>
+class IdIndexTable {
+    static_assert(N < 0xFFFF, "IdIndexTable indices are 16-bit");
+
+    static constexpr size_t tableSize() {
+        size_t size = 2;
+        while (size < 2 * N) size <<= 1;
+        return size;
+    }
+
+public:
+    static constexpr int NOT_FOUND = -1;
+    static constexpr size_t TABLE_SIZE = tableSize();
+
+    constexpr IdIndexTable() = default;
+
+    /// Duplicate IDs resolve to their first index
+    constexpr explicit IdIndexTable(const std::array<Id, N>& ids) {
+        dense_ = N > 0;
+        for (size_t i = 0; i < N; ++i) {
+            if (ids[i] != static_cast<Id>(ids[0] + i)) dense_ = false;
+        }
+        if (N > 0) base_ = ids[0];
+
+        for (size_t i = 0; i < N; ++i) {
+            size_t slot = hash(ids[i]);
+            while (index_[slot] != EMPTY && ids_[slot] != ids[i]) {
+                slot = (slot + 1) & (TABLE_SIZE - 1);
+            }
+            if (index_[slot] == EMPTY) {
+                ids_[slot] = ids[i];
+                index_[slot] = static_cast<uint16_t>(i);
+            }
+        }
+    }
+
+    /// Index of id, or NOT_FOUND
+    constexpr int find(Id id) const {
+        if (dense_) {
+            const Id offset = static_cast<Id>(id - base_);
+            return offset < N ? static_cast<int>(offset) : NOT_FOUND;
+        }
+        size_t slot = hash(id);
+        while (index_[slot] != EMPTY) {
+            if (ids_[slot] == id) return index_[slot];
+            slot = (slot + 1) & (TABLE_SIZE - 1);
+        }
+        return NOT_FOUND;
+    }
+
+private:
+    static constexpr uint16_t EMPTY = 0xFFFF;
+
+    static constexpr size_t hash(Id id) {
+        // Fibonacci hashing spreads sequential and strided IDs alike
+        return static_cast<size_t>((static_cast<uint32_t>(id) * 2654435769u) >> 16) & (TABLE_SIZE - 1);
+    }
+
+    static constexpr std::array<uint16_t, TABLE_SIZE> emptyIndex() {
+        std::array<uint16_t, TABLE_SIZE> index{};
+        for (auto& slot : index) slot = EMPTY;
+        return index;
+    }
+
+    std::array<Id, TABLE_SIZE> ids_{};
+    std::array<uint16_t, TABLE_SIZE> index_ = emptyIndex();
+    Id base_ = 0;
+    bool dense_ = false;
+};
+
+}  // namespace oc::hal::teensy
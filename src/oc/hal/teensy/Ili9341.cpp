@@ -1,5 +1,7 @@
 #include "Ili9341.hpp"
 
+#include <algorithm>
+
 #include <oc/log/Log.hpp>
 
 namespace oc::hal::teensy {
@@ -39,7 +41,21 @@ Ili9341::DiffStats toDiffStats(const ILI9341_T4::DiffBuff& diff) {
     return stats;
 }
 
-#if defined(PERF_LOG)
+/// Clamp a rect to the screen; false if nothing is left
+bool clipToScreen(interface::Rect& rect, uint16_t width, uint16_t height) {
+    if (rect.x1 < 0) rect.x1 = 0;
+    if (rect.y1 < 0) rect.y1 = 0;
+    if (rect.x2 > static_cast<int32_t>(width) - 1) rect.x2 = static_cast<int32_t>(width) - 1;
+    if (rect.y2 > static_cast<int32_t>(height) - 1) rect.y2 = static_cast<int32_t>(height) - 1;
+    return rect.x1 <= rect.x2 && rect.y1 <= rect.y2;
+}
+
+bool isFullFrame(const interface::Rect& rect, uint16_t width, uint16_t height) {
+    return rect.x1 == 0 && rect.y1 == 0 &&
+           rect.x2 == static_cast<int32_t>(width) - 1 &&
+           rect.y2 == static_cast<int32_t>(height) - 1;
+}
+
 uint32_t rectPixelCount(const interface::Rect& rect) {
     const int32_t width = rect.x2 - rect.x1 + 1;
     const int32_t height = rect.y2 - rect.y1 + 1;
@@ -47,7 +63,17 @@ uint32_t rectPixelCount(const interface::Rect& rect) {
 
     return static_cast<uint32_t>(width) * static_cast<uint32_t>(height);
 }
-#endif
+
+/// Overlapping or sharing an edge: uploading the union costs no extra pixels
+bool touches(const interface::Rect& a, const interface::Rect& b) {
+    return a.x1 <= b.x2 + 1 && b.x1 <= a.x2 + 1 &&
+           a.y1 <= b.y2 + 1 && b.y1 <= a.y2 + 1;
+}
+
+interface::Rect unite(const interface::Rect& a, const interface::Rect& b) {
+    return {std::min(a.x1, b.x1), std::min(a.y1, b.y1),
+            std::max(a.x2, b.x2), std::max(a.y2, b.y2)};
+}
 
 }  // namespace
 
@@ -64,16 +90,18 @@ FLASHMEM oc::type::Result<void> Ili9341::init() {
 
     if (initialized_) return R::ok();
 
-    if (!buffers_.framebuffer) {
-        return R::err({E::INVALID_ARGUMENT, "framebuffer required"});
-    }
-    if (!buffers_.diff1) {
-        return R::err({E::INVALID_ARGUMENT, "diff1 buffer required"});
-    }
-
-    diff1_ = std::make_unique<ILI9341_T4::DiffBuff>(buffers_.diff1, effectiveDiff1Size_);
-    if (buffers_.diff2) {
-        diff2_ = std::make_unique<ILI9341_T4::DiffBuff>(buffers_.diff2, effectiveDiff2Size_);
+    if (!config_.bandMode) {
+        if (!buffers_.framebuffer) {
+            return R::err({E::INVALID_ARGUMENT, "framebuffer required"});
+        }
+        if (!buffers_.diff1) {
+            return R::err({E::INVALID_ARGUMENT, "diff1 buffer required"});
+        }
+
+        diff1_ = std::make_unique<ILI9341_T4::DiffBuff>(buffers_.diff1, effectiveDiff1Size_);
+        if (buffers_.diff2) {
+            diff2_ = std::make_unique<ILI9341_T4::DiffBuff>(buffers_.diff2, effectiveDiff2Size_);
+        }
     }
 
     tft_.emplace(config_.csPin, config_.dcPin, config_.sckPin,
@@ -85,12 +113,17 @@ FLASHMEM oc::type::Result<void> Ili9341::init() {
 
     tft_->setRotation(config_.rotation);
     tft_->invertDisplay(config_.invertDisplay);
-    tft_->setFramebuffer(buffers_.framebuffer);
-
-    if (diff2_) {
-        tft_->setDiffBuffers(diff1_.get(), diff2_.get());
+    if (config_.bandMode) {
+        // No internal framebuffer: the driver uploads each region directly
+        tft_->setFramebuffer(nullptr);
     } else {
-        tft_->setDiffBuffers(diff1_.get());
+        tft_->setFramebuffer(buffers_.framebuffer);
+
+        if (diff2_) {
+            tft_->setDiffBuffers(diff1_.get(), diff2_.get());
+        } else {
+            tft_->setDiffBuffers(diff1_.get());
+        }
     }
 
     tft_->setVSyncSpacing(config_.vsyncSpacing);
@@ -100,6 +133,10 @@ FLASHMEM oc::type::Result<void> Ili9341::init() {
     tft_->clear(0x0000);
     resetPerfStats();
 
+    tune_target_fps_ = config_.autoTune.targetFps > 0
+        ? config_.autoTune.targetFps
+        : config_.refreshRate / std::max<uint16_t>(config_.vsyncSpacing, 1);
+
 #if defined(PERF_LOG)
     OC_LOG_INFO(
         "[Perf][Display][Config] framebufferBytes={} diff1Bytes={} diff2Bytes={} "
@@ -130,8 +167,54 @@ void Ili9341::flush(const void* buffer, const interface::Rect& area) {
 
     const uint32_t flushStartUs = micros();
 #endif
-    // Async update - false = don't wait for redraw
-    tft_->update(reinterpret_cast<uint16_t*>(const_cast<void*>(buffer)), false);
+    const uint32_t startUs = micros();
+    const auto* pixels = static_cast<const uint16_t*>(buffer);
+    interface::Rect rect = area;
+    const bool hasPixels = clipToScreen(rect, config_.width, config_.height);
+    const bool fullFrame = hasPixels && isFullFrame(rect, config_.width, config_.height);
+
+    if (config_.bandMode) {
+        if (hasPixels) {
+            // Buffer holds just the area: stride by the area width, skip clipped-off pixels
+            const int32_t stride = area.x2 - area.x1 + 1;
+            tft_->updateRegion(true,
+                               pixels + (rect.y1 - area.y1) * stride + (rect.x1 - area.x1),
+                               rect.x1, rect.x2, rect.y1, rect.y2,
+                               stride);
+            ++redraw_requests_;
+        }
+    } else if (!config_.partialFlush || fullFrame) {
+        // A full frame supersedes anything still batched
+        batch_count_ = 0;
+        batch_source_ = nullptr;
+        // Async update - false = don't wait for redraw
+        tft_->update(pixels, false);
+        ++redraw_requests_;
+    } else if (hasPixels && config_.batchFlushes) {
+        // Batching re-reads the buffer at commit time, so it needs a full-frame one
+        if (batch_source_ != nullptr && batch_source_ != pixels) commitFrame();
+        batch_source_ = pixels;
+        addBatchRegion_(rect);
+    } else if (hasPixels) {
+        pushRegion_(pixels, rect, true);
+    }
+
+    const uint32_t flushUs = micros() - startUs;
+    flush_totals_.flushes += 1;
+    flush_totals_.timeUs += flushUs;
+    flush_totals_.maxTimeUs = std::max(flush_totals_.maxTimeUs, flushUs);
+    flush_totals_.bytes += (config_.partialFlush || config_.bandMode)
+        ? static_cast<uint64_t>(hasPixels ? rectPixelCount(rect) : 0) * sizeof(uint16_t)
+        : static_cast<uint64_t>(config_.framebufferSize()) * sizeof(uint16_t);
+
+    if (config_.autoTune.enabled) updateAutoTune(millis());
+
+    if (telemetry_) {
+        const uint32_t telemetryNowMs = millis();
+        if (telemetry_->due(TelemetryType::DISPLAY_PERF, telemetryNowMs)) {
+            sendTelemetry_(telemetryNowMs);
+        }
+    }
 #if defined(PERF_LOG)
     const uint32_t flushCallUs = micros() - flushStartUs;
     const uint32_t rectPixels = rectPixelCount(area);
@@ -142,13 +225,11 @@ void Ili9341::flush(const void* buffer, const interface::Rect& area) {
         perfWindow.maxFlushCallUs = flushCallUs;
     }
 
-    if (area.x1 == 0 && area.y1 == 0 &&
-        area.x2 == static_cast<int32_t>(config_.width) - 1 &&
-        area.y2 == static_cast<int32_t>(config_.height) - 1) {
+    if (fullFrame) {
         ++perfWindow.fullFrameRects;
     }
 
-    if ((nowMs - perfWindow.startedAtMs) >= 1000) {
+    if (!telemetry_ && (nowMs - perfWindow.startedAtMs) >= 1000) {
         const auto snapshot = perfSnapshot();
         const uint32_t avgFlushCallUs =
             (perfWindow.flushCount > 0) ? (perfWindow.flushCallTimeUs / perfWindow.flushCount) : 0;
@@ -195,6 +276,199 @@ void Ili9341::flush(const void* buffer, const interface::Rect& area) {
 #endif
 }
 
+void Ili9341::commitFrame() {
+    if (!initialized_ || batch_count_ == 0) return;
+
+    // Copy every region into the driver framebuffer, redraw once on the last
+    for (size_t i = 0; i < batch_count_; ++i) {
+        pushRegion_(batch_source_, batch_regions_[i], i + 1 == batch_count_);
+    }
+    batch_stats_.commits += 1;
+    batch_stats_.regions += static_cast<uint32_t>(batch_count_);
+    batch_count_ = 0;
+    batch_source_ = nullptr;
+}
+
+FLASHMEM void Ili9341::setDiffGap(uint16_t gap) {
+    config_.diffGap = gap;
+    if (tft_) tft_->setDiffGap(gap);
+}
+
+FLASHMEM void Ili9341::setVSyncSpacing(uint16_t spacing) {
+    config_.vsyncSpacing = spacing;
+    if (tft_) tft_->setVSyncSpacing(spacing);
+}
+
+FLASHMEM void Ili9341::setLateStartRatio(float ratio) {
+    config_.lateStartRatio = ratio;
+    if (tft_) tft_->setLateStartRatio(ratio);
+}
+
+void Ili9341::updateAutoTune(uint32_t nowMs) {
+    // Band mode has no diff and no async upload to tune
+    if (!initialized_ || !diff1_) return;
+    const Ili9341AutoTune& tune = config_.autoTune;
+
+    if (tune_.startedAtMs == 0) {
+        tune_.startedAtMs = nowMs;
+        tune_.counters = tuneCounters_();
+        tune_.requests = redraw_requests_;
+        return;
+    }
+    const uint32_t elapsedMs = nowMs - tune_.startedAtMs;
+    if (elapsedMs < tune.intervalMs) return;
+
+    // Cumulative counters: differences stay exact across resetPerfStats()
+    const TuneCounters now = tuneCounters_();
+    const uint32_t windowFrames = now.frames - tune_.counters.frames;
+    const uint32_t windowTeared = now.teared - tune_.counters.teared;
+    const uint32_t windowOverflow = now.diffOverflow - tune_.counters.diffOverflow;
+    const uint32_t windowRequests = redraw_requests_ - tune_.requests;
+    const bool computedAny = now.diffComputed != tune_.counters.diffComputed;
+
+    tune_.startedAtMs = nowMs;
+    tune_.counters = now;
+    tune_.requests = redraw_requests_;
+
+    // Nothing was drawn: no evidence either way
+    if (windowFrames == 0 || !computedAny) return;
+
+    const float fps = static_cast<float>(windowFrames) * 1000.0f / static_cast<float>(elapsedMs);
+    // Low fps only counts when the UI asked for at least targetFps and some
+    // redraws were not shown: LVGL flushes on change, so a mostly static
+    // screen is not a slow one
+    const float requestedFps = static_cast<float>(windowRequests) * 1000.0f / static_cast<float>(elapsedMs);
+    const bool belowTarget = fps + 0.5f < static_cast<float>(tune_target_fps_) &&
+                             requestedFps + 0.5f >= static_cast<float>(tune_target_fps_) &&
+                             windowRequests > windowFrames;
+    const float tearRatio = static_cast<float>(windowTeared) / static_cast<float>(windowFrames);
+    const uint16_t oldGap = config_.diffGap;
+    const uint16_t oldSpacing = config_.vsyncSpacing;
+    const float oldRatio = config_.lateStartRatio;
+
+    if (windowOverflow > 0) {
+        tune_.cleanWindows = 0;
+        if (config_.diffGap < tune.maxDiffGap) {
+            setDiffGap(std::min<uint16_t>(config_.diffGap + 2, tune.maxDiffGap));
+        }
+    } else if (tearRatio > tune.maxTearRatio) {
+        tune_.cleanWindows = 0;
+        if (config_.lateStartRatio > tune.minLateStartRatio) {
+            setLateStartRatio(std::max(config_.lateStartRatio - 0.1f, tune.minLateStartRatio));
+        }
+    } else if (belowTarget) {
+        tune_.cleanWindows = 0;
+        if (config_.lateStartRatio < tune.maxLateStartRatio) {
+            setLateStartRatio(std::min(config_.lateStartRatio + 0.05f, tune.maxLateStartRatio));
+        } else if (config_.vsyncSpacing > 1) {
+            setVSyncSpacing(config_.vsyncSpacing - 1);
+        }
+    } else if (++tune_.cleanWindows >= tune.cleanWindowsBeforeRelax) {
+        tune_.cleanWindows = 0;
+        if (config_.diffGap > tune.minDiffGap) {
+            setDiffGap(config_.diffGap - 1);
+        }
+    }
+
+    if (config_.diffGap != oldGap || config_.vsyncSpacing != oldSpacing ||
+        config_.lateStartRatio != oldRatio) {
+        ++tune_adjustments_;
+#if defined(PERF_LOG)
+        OC_LOG_INFO("[Perf][Display][Tune] fps={} tearRatio={} overflow={} diffGap={} "
+                    "vsyncSpacing={} lateStartRatio={}",
+                    fps, tearRatio, windowOverflow, config_.diffGap,
+                    config_.vsyncSpacing, config_.lateStartRatio);
+#endif
+    }
+}
+
+void Ili9341::sendTelemetry_(uint32_t nowMs) {
+    const PerfSnapshot snapshot = perfSnapshot();
+
+    TelemetryDisplayPerf record{};
+    record.frames = snapshot.frames;
+    record.currentFps = snapshot.currentFps;
+    record.averageFps = snapshot.averageFps;
+    record.uploadRateFps = snapshot.uploadRateFps;
+    record.diffSpeedUp = snapshot.diffSpeedUp;
+    record.pixelsRatio = snapshot.pixelsRatio;
+    record.tearedFrames = snapshot.tearedFrames;
+    record.tearRatio = snapshot.tearRatio;
+    record.cpuTimeAvgUs = snapshot.cpuTimeUs.avg;
+    record.cpuTimeMaxUs = snapshot.cpuTimeUs.max;
+    record.uploadTimeAvgUs = snapshot.uploadTimeUs.avg;
+    record.uploadTimeMaxUs = snapshot.uploadTimeUs.max;
+    record.pixelsPerFrameAvg = snapshot.pixelsPerFrame.avg;
+    record.transactionsPerFrameAvg = snapshot.transactionsPerFrame.avg;
+    record.marginPerFrameAvg = snapshot.marginPerFrame.avg;
+    record.diff1Computed = snapshot.diff1.computed;
+    record.diff1Overflow = snapshot.diff1.overflow;
+    record.diff1SizeAvg = snapshot.diff1.sizeBytes.avg;
+    record.diff1TimeAvgUs = snapshot.diff1.computeTimeUs.avg;
+    record.diff2Computed = snapshot.diff2.computed;
+    record.diff2Overflow = snapshot.diff2.overflow;
+    record.diff2SizeAvg = snapshot.diff2.sizeBytes.avg;
+    record.diff2TimeAvgUs = snapshot.diff2.computeTimeUs.avg;
+    record.flushes = snapshot.flushes;
+    record.bytesPerFrame = snapshot.bytesPerFrame;
+    record.flushTimeAvgUs = snapshot.flushTimeAvgUs;
+    record.flushTimeMaxUs = snapshot.flushTimeMaxUs;
+    record.batchCommits = snapshot.batch.commits;
+    record.batchRegions = snapshot.batch.regions;
+    record.tuneAdjustments = snapshot.tuneAdjustments;
+    record.diffGap = config_.diffGap;
+    record.vsyncSpacing = config_.vsyncSpacing;
+    record.lateStartRatio = config_.lateStartRatio;
+    telemetry_->send(record, nowMs);
+
+    resetPerfStats();
+}
+
+void Ili9341::pushRegion_(const uint16_t* pixels, const interface::Rect& rect, bool redrawNow) {
+    // Buffer is full-frame sized: point at the rect and stride by the screen width.
+    // Only this region is copied, diffed and uploaded.
+    tft_->updateRegion(redrawNow,
+                       pixels + rect.y1 * config_.width + rect.x1,
+                       rect.x1, rect.x2, rect.y1, rect.y2,
+                       config_.width);
+    if (redrawNow) ++redraw_requests_;
+}
+
+void Ili9341::addBatchRegion_(interface::Rect rect) {
+    batch_stats_.flushes += 1;
+
+    // Fold into every region it touches; the union may reach further ones
+    for (size_t i = 0; i < batch_count_;) {
+        if (touches(rect, batch_regions_[i])) {
+            rect = unite(rect, batch_regions_[i]);
+            batch_regions_[i] = batch_regions_[--batch_count_];
+            batch_stats_.merges += 1;
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (batch_count_ < batch_regions_.size()) {
+        batch_regions_[batch_count_++] = rect;
+        return;
+    }
+
+    // Set full: grow the region that gains the fewest pixels
+    size_t best = 0;
+    uint32_t bestGrowth = UINT32_MAX;
+    for (size_t i = 0; i < batch_count_; ++i) {
+        const uint32_t growth = rectPixelCount(unite(rect, batch_regions_[i])) -
+                                rectPixelCount(batch_regions_[i]);
+        if (growth < bestGrowth) {
+            bestGrowth = growth;
+            best = i;
+        }
+    }
+    batch_regions_[best] = unite(rect, batch_regions_[best]);
+    batch_stats_.merges += 1;
+}
+
 FLASHMEM void Ili9341::waitAsyncComplete() {
     if (tft_) tft_->waitUpdateAsyncComplete();
 }
@@ -228,14 +502,47 @@ FLASHMEM Ili9341::PerfSnapshot Ili9341::perfSnapshot() const {
 
     if (diff1_) snapshot.diff1 = toDiffStats(*diff1_);
     if (diff2_) snapshot.diff2 = toDiffStats(*diff2_);
+    snapshot.batch = batch_stats_;
+    snapshot.tuneAdjustments = tune_adjustments_;
+    snapshot.flushes = flush_totals_.flushes;
+    snapshot.flushTimeMaxUs = flush_totals_.maxTimeUs;
+    if (flush_totals_.flushes > 0) {
+        snapshot.flushTimeAvgUs = static_cast<float>(flush_totals_.timeUs) /
+                                  static_cast<float>(flush_totals_.flushes);
+    }
+    if (snapshot.frames > 0) {
+        snapshot.bytesPerFrame = static_cast<float>(flush_totals_.bytes) /
+                                 static_cast<float>(snapshot.frames);
+    }
 
     return snapshot;
 }
 
+Ili9341::TuneCounters Ili9341::tuneCounters_() const {
+    TuneCounters counters = tune_carry_;
+    if (tft_) {
+        counters.frames += tft_->statsNbFrames();
+        counters.teared += tft_->statsNbTeared();
+    }
+    if (diff1_) {
+        counters.diffComputed += diff1_->statsNbComputed();
+        counters.diffOverflow += diff1_->statsNbOverflow();
+    }
+    if (diff2_) {
+        counters.diffComputed += diff2_->statsNbComputed();
+        counters.diffOverflow += diff2_->statsNbOverflow();
+    }
+    return counters;
+}
+
 FLASHMEM void Ili9341::resetPerfStats() {
+    // Fold the driver counters in first so the auto-tuner's totals keep counting
+    tune_carry_ = tuneCounters_();
     if (tft_) tft_->statsReset();
     if (diff1_) diff1_->statsReset();
     if (diff2_) diff2_->statsReset();
+    batch_stats_ = {};
+    flush_totals_ = {};
 }
 
 }  // namespace oc::hal::teensy
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -9,8 +10,34 @@
 #include <oc/type/Result.hpp>
 #include <oc/interface/IDisplay.hpp>
 
+#include "Telemetry.hpp"
+
 namespace oc::hal::teensy {
 
+/**
+ * @brief Runtime tuning of the DMA parameters from the driver statistics
+ *
+ * Every intervalMs the driver looks at the frames since the last check and
+ * makes at most one adjustment:
+ * - diff buffer overflow: raise diffGap (fewer, larger transactions)
+ * - tearing above maxTearRatio: lower lateStartRatio
+ * - below targetFps without tearing, while redraws were requested at least at
+ *   targetFps and not all were shown: raise lateStartRatio, then lower
+ *   vsyncSpacing
+ * - clean windows in a row: lower diffGap back towards minDiffGap
+ */
+struct Ili9341AutoTune {
+    bool enabled = false;
+    uint32_t intervalMs = 2000;
+    uint32_t targetFps = 0;           ///< 0 = refreshRate / initial vsyncSpacing
+    float maxTearRatio = 0.02f;
+    uint16_t minDiffGap = 4;
+    uint16_t maxDiffGap = 32;
+    float minLateStartRatio = 0.1f;
+    float maxLateStartRatio = 0.9f;
+    uint8_t cleanWindowsBeforeRelax = 4;
+};
+
 /**
  * @brief Hardware configuration for ILI9341 display (constexpr-friendly)
  *
@@ -41,10 +68,30 @@ struct Ili9341Config {
     uint16_t irqPriority = 128;       ///< DMA IRQ priority
     float lateStartRatio = 0.3f;     ///< Late start optimization
     uint32_t refreshRate = 60;       ///< Target refresh Hz
+    bool partialFlush = true;        ///< Diff/upload only the flushed area (false = whole frame)
+    /**
+     * Collect partial flushes and upload them together in commitFrame().
+     * The flushed buffer must be full-frame and keep its content until the
+     * commit (LVGL direct mode).
+     */
+    bool batchFlushes = false;
+    /**
+     * Band rendering: no framebuffer or diff buffers. LVGL renders into
+     * area-sized band buffers (partial render mode) and each flush is
+     * uploaded straight from it, synchronously and without diffing. Saves the
+     * 150 KB framebuffer at the cost of uploading every flushed pixel.
+     */
+    bool bandMode = false;
+
+    // ── Runtime tuning ──
+    Ili9341AutoTune autoTune{};
 
     /// Calculate framebuffer size in pixels
     constexpr size_t framebufferSize() const { return width * height; }
 
+    /// Band buffer size in pixels for a band of `lines` full-width rows
+    constexpr size_t bandBufferSize(uint16_t lines) const { return width * lines; }
+
     /// Recommended diff buffer size for this resolution
     constexpr size_t recommendedDiffSize() const {
         // ~8KB for 320x240, scales with resolution
@@ -57,10 +104,11 @@ struct Ili9341Config {
  *
  * All buffers must be in DMAMEM on Teensy 4.x.
  * Sizes are auto-calculated from config if set to 0.
+ * None of them is used in band mode (Ili9341Config::bandMode).
  */
 struct Ili9341Buffers {
-    uint16_t* framebuffer = nullptr;  ///< Required: DMAMEM uint16_t[width*height]
-    uint8_t* diff1 = nullptr;         ///< Required: DMAMEM for diff algorithm
+    uint16_t* framebuffer = nullptr;  ///< Required (except band mode): DMAMEM uint16_t[width*height]
+    uint8_t* diff1 = nullptr;         ///< Required (except band mode): DMAMEM for diff algorithm
     uint8_t* diff2 = nullptr;         ///< Optional: enables double-buffered diff
     size_t diff1Size = 0;             ///< 0 = auto-calculate from config
     size_t diff2Size = 0;             ///< 0 = auto-calculate from config
@@ -85,6 +133,11 @@ struct Ili9341Buffers {
  *     .diff2 = Buffers::diff2
  * });
  * display->init();
+ *
+ * // Band mode: no framebuffer, LVGL renders 40-line bands
+ * constexpr Ili9341Config BAND_CONFIG = {.bandMode = true};
+ * DMAMEM uint16_t band[BAND_CONFIG.bandBufferSize(40)];
+ * display.emplace(BAND_CONFIG, Ili9341Buffers{});
  * @endcode
  */
 class Ili9341 : public interface::IDisplay {
@@ -105,6 +158,14 @@ public:
         StatSummary computeTimeUs;
     };
 
+    /// Flush batching counters (batchFlushes mode)
+    struct BatchStats {
+        uint32_t flushes = 0;   ///< Partial flushes collected
+        uint32_t merges = 0;    ///< Flushes folded into an overlapping or adjacent region
+        uint32_t commits = 0;   ///< Frames uploaded by commitFrame()
+        uint32_t regions = 0;   ///< Regions uploaded over all commits
+    };
+
     struct PerfSnapshot {
         bool valid = false;
         uint32_t frames = 0;
@@ -123,6 +184,12 @@ public:
         StatSummary realVSyncSpacing;
         DiffStats diff1;
         DiffStats diff2;
+        BatchStats batch;
+        uint32_t tuneAdjustments = 0;   ///< Parameter changes made by the auto-tuner
+        uint32_t flushes = 0;           ///< flush() calls since the last reset
+        float bytesPerFrame = 0.0f;     ///< Pixel bytes handed to the driver per frame
+        float flushTimeAvgUs = 0.0f;    ///< Time spent inside flush() (band mode: the upload)
+        uint32_t flushTimeMaxUs = 0;
     };
 
     Ili9341(const Ili9341Config& config, const Ili9341Buffers& buffers);
@@ -141,6 +208,47 @@ public:
     uint16_t width() const override { return config_.width; }
     uint16_t height() const override { return config_.height; }
 
+    static constexpr size_t MAX_BATCH_REGIONS = 8;
+
+    /// @name Live DMA tuning (no init() needed; values are kept in config())
+    ///@{
+    void setDiffGap(uint16_t gap);
+    void setVSyncSpacing(uint16_t spacing);
+    void setLateStartRatio(float ratio);
+    ///@}
+
+    /// Current configuration, including live-tuned values
+    const Ili9341Config& config() const { return config_; }
+
+    /**
+     * @brief Run one auto-tune evaluation if intervalMs has elapsed
+     *
+     * Called from flush() when autoTune.enabled; exposed so idle screens can
+     * still be tuned from the main loop.
+     */
+    void updateAutoTune(uint32_t nowMs);
+
+    /**
+     * @brief Upload the regions collected since the last commit (batchFlushes)
+     *
+     * Call once per refresh cycle after the last flush, e.g. right after
+     * lv_timer_handler(). Each region is copied once and a single redraw
+     * covers all of them. A full-frame flush commits on its own.
+     */
+    void commitFrame();
+
+    /// Regions waiting for commitFrame()
+    size_t pendingRegions() const { return batch_count_; }
+
+    /**
+     * @brief Stream PerfSnapshot as TelemetryDisplayPerf records
+     *
+     * Sent from flush() at the channel's cadence; stats are reset after each
+     * record, and the PERF_LOG text report is skipped while a channel is set.
+     * The channel must outlive this driver.
+     */
+    void setTelemetry(TelemetryChannel* channel) { telemetry_ = channel; }
+
     void waitAsyncComplete();
     PerfSnapshot perfSnapshot() const;
     void resetPerfStats();
@@ -153,6 +261,46 @@ private:
     std::optional<ILI9341_T4::ILI9341Driver> tft_;
     std::unique_ptr<ILI9341_T4::DiffBuff> diff1_;
     std::unique_ptr<ILI9341_T4::DiffBuff> diff2_;
+    /// Driver counters summed across resetPerfStats() calls
+    struct TuneCounters {
+        uint32_t frames = 0;
+        uint32_t teared = 0;
+        uint32_t diffComputed = 0;
+        uint32_t diffOverflow = 0;
+    };
+
+    /// Cumulative counters at the previous auto-tune evaluation
+    struct TuneBaseline {
+        uint32_t startedAtMs = 0;
+        TuneCounters counters{};
+        uint32_t requests = 0;
+        uint8_t cleanWindows = 0;
+    };
+
+    /// Driver-side flush accounting, complements the ILI9341_T4 stats
+    struct FlushTotals {
+        uint32_t flushes = 0;
+        uint64_t bytes = 0;
+        uint64_t timeUs = 0;
+        uint32_t maxTimeUs = 0;
+    };
+
+    TuneCounters tuneCounters_() const;
+    void sendTelemetry_(uint32_t nowMs);
+    void pushRegion_(const uint16_t* pixels, const interface::Rect& rect, bool redrawNow);
+    void addBatchRegion_(interface::Rect rect);
+
+    std::array<interface::Rect, MAX_BATCH_REGIONS> batch_regions_{};
+    size_t batch_count_ = 0;
+    const uint16_t* batch_source_ = nullptr;
+    BatchStats batch_stats_{};
+    FlushTotals flush_totals_{};
+    TuneBaseline tune_{};
+    TuneCounters tune_carry_{};
+    uint32_t redraw_requests_ = 0;  ///< Redraws handed to the driver, never reset
+    uint32_t tune_adjustments_ = 0;
+    uint32_t tune_target_fps_ = 0;
+    TelemetryChannel* telemetry_ = nullptr;
     bool initialized_ = false;
 };
 
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <atomic>
+#include <utility>
+
+#include <oc/hal/common/embedded/ButtonDef.hpp>
+#include <oc/hal/common/embedded/GpioPin.hpp>
+#include <oc/hal/teensy/ButtonDebouncer.hpp>
+#include <oc/hal/teensy/SpscRing.hpp>
+#include <oc/hal/teensy/TeensyGpio.hpp>
+#include <oc/type/Result.hpp>
+#include <oc/interface/IButton.hpp>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Edge-driven button input for MCU pins
+ *
+ * Each button pin gets a CHANGE interrupt that timestamps the new level into
+ * a lock-free ring. update() only drains that ring and applies the same
+ * per-button lockout debouncing as ButtonController, so an idle update() is a
+ * ring check and a press is timestamped by the ISR, not by the loop period.
+ * Buttons whose bounce ended inside the lockout window are re-read once it
+ * expires, so the final level is never lost.
+ *
+ * All Teensy 4.x pin interrupts are dispatched from one GPIO vector, so the
+ * per-pin ISRs never preempt each other and act as a single ring producer.
+ *
+ * @code
+ * InterruptButtonController<8> buttons(Config::Button::BUTTONS);
+ * buttons.init();
+ * @endcode
+ *
+ * @note MCU pins only; use ButtonController for multiplexed buttons.
+ * @note One instance per button count N (the ISR trampolines are static).
+ */
+template <size_t N>
+class InterruptButtonController : public interface::IButton {
+    static_assert(N > 0 && N <= 256, "InterruptButtonController supports 1-256 buttons");
+
+public:
+    using ButtonDef = common::embedded::ButtonDef;
+
+    /// Edges buffered between two update() calls before a resync is forced
+    static constexpr size_t EDGE_QUEUE_CAPACITY = 64;
+
+    explicit InterruptButtonController(const std::array<ButtonDef, N>& buttons, uint8_t debounceMs = 5)
+        : buttons_(buttons), debounce_ms_(debounceMs) {
+        states_.fill(false);
+        last_change_.fill(0);
+    }
+
+    ~InterruptButtonController() {
+        if (instance_ != this) return;
+        for (const auto& btn : buttons_) {
+            detachInterrupt(btn.pin.pin);
+        }
+        instance_ = nullptr;
+    }
+
+    InterruptButtonController(const InterruptButtonController&) = delete;
+    InterruptButtonController& operator=(const InterruptButtonController&) = delete;
+
+    oc::type::Result<void> init() override {
+        if (initialized_) return oc::type::Result<void>::ok();
+
+        for (const auto& btn : buttons_) {
+            if (btn.pin.source != common::embedded::GpioPin::Source::MCU) {
+                return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "Interrupt buttons need MCU pins"});
+            }
+        }
+        if (instance_ != nullptr) {
+            return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "InterruptButtonController<N> already in use"});
+        }
+
+        for (size_t i = 0; i < N; ++i) {
+            ::pinMode(buttons_[i].pin.pin, INPUT_PULLUP);
+            pins_[i] = FastPin::of(buttons_[i].pin.pin);
+        }
+
+        // Held buttons are reported by the first update(), like ButtonController
+        for (size_t i = 0; i < N; ++i) {
+            pending_[i >> 5] |= 1u << (i & 31);
+        }
+
+        instance_ = this;
+        attachAll_(std::make_index_sequence<N>{});
+        initialized_ = true;
+        return oc::type::Result<void>::ok();
+    }
+
+    void update(uint32_t currentTimeMs) override {
+        if (!initialized_) return;
+
+        Edge edge;
+        while (edges_.pop(edge)) {
+            apply_(edge.index, edge.pressed, edge.timeMs);
+        }
+
+        // Lost edges: every button is re-read below
+        if (overflow_.exchange(false, std::memory_order_acquire)) {
+            for (size_t i = 0; i < N; ++i) {
+                pending_[i >> 5] |= 1u << (i & 31);
+            }
+        }
+
+        for (size_t w = 0; w < pending_.size(); ++w) {
+            uint32_t bits = pending_[w];
+            while (bits != 0) {
+                const size_t i = w * 32 + static_cast<size_t>(__builtin_ctz(bits));
+                bits &= bits - 1;
+                if (currentTimeMs - last_change_[i] < debounce_ms_) continue;
+
+                pending_[w] &= ~(1u << (i & 31));
+                const bool pressed = readPressed_(i);
+                if (pressed != states_[i]) accept_(i, pressed, currentTimeMs);
+            }
+        }
+    }
+
+    bool isPressed(oc::type::ButtonID id) const override {
+        for (size_t i = 0; i < N; ++i) {
+            if (buttons_[i].id == id) return states_[i];
+        }
+        return false;
+    }
+
+    void setCallback(oc::type::ButtonCallback cb) override { callback_ = cb; }
+
+    /// Edges dropped because the ring was full (each one forces a resync)
+    uint32_t droppedEdges() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Edge {
+        uint32_t timeMs;
+        uint8_t index;
+        bool pressed;
+    };
+
+    template <size_t... I>
+    void attachAll_(std::index_sequence<I...>) {
+        (attachInterrupt(buttons_[I].pin.pin, &isr_<I>, CHANGE), ...);
+    }
+
+    template <size_t I>
+    static void isr_() {
+        if (InterruptButtonController* self = instance_) self->onEdge_(I);
+    }
+
+    void onEdge_(size_t index) {
+        const Edge edge{millis(), static_cast<uint8_t>(index), readPressed_(index)};
+        if (!edges_.push(edge)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            overflow_.store(true, std::memory_order_release);
+        }
+    }
+
+    bool readPressed_(size_t index) const {
+        const bool level = pins_[index].read();
+        return buttons_[index].activeLow ? !level : level;
+    }
+
+    void apply_(size_t index, bool pressed, uint32_t timeMs) {
+        uint32_t& pending = pending_[index >> 5];
+        const uint32_t bit = 1u << (index & 31);
+
+        if (pressed == states_[index]) {
+            pending &= ~bit;  // Bounced back to the accepted level
+        } else if (timeMs - last_change_[index] >= debounce_ms_) {
+            pending &= ~bit;
+            accept_(index, pressed, timeMs);
+        } else {
+            pending |= bit;  // Settle once the lockout expires
+        }
+    }
+
+    void accept_(size_t index, bool pressed, uint32_t timeMs) {
+        states_[index] = pressed;
+        last_change_[index] = timeMs;
+        if (callback_) {
+            callback_(buttons_[index].id,
+                      pressed ? oc::type::ButtonEvent::PRESSED : oc::type::ButtonEvent::RELEASED);
+        }
+    }
+
+    static inline InterruptButtonController* instance_ = nullptr;
+
+    std::array<ButtonDef, N> buttons_;
+    std::array<FastPin, N> pins_{};
+    uint8_t debounce_ms_;
+
+    SpscRing<Edge, EDGE_QUEUE_CAPACITY> edges_;
+    std::atomic<bool> overflow_{false};
+    std::atomic<uint32_t> dropped_{0};
+
+    std::array<bool, N> states_;
+    std::array<uint32_t, N> last_change_;
+    ButtonWords<N> pending_{};  // Buttons whose level may differ from states_
+    oc::type::ButtonCallback callback_;
+    bool initialized_ = false;
+};
+
+}  // namespace oc::hal::teensy
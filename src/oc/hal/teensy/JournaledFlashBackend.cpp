@@ -0,0 +1,335 @@
+#include "JournaledFlashBackend.hpp"
+
+#include <cstring>
+#include <utility>
+
+// Flash primitives of the Teensy 4 core EEPROM emulation (eeprom.c). Both run
+// from RAM with interrupts disabled and invalidate the data cache afterwards.
+extern "C" {
+void eepromemu_flash_write(void* addr, const void* data, uint32_t len);
+void eepromemu_flash_erase_sector(void* addr);
+}
+
+namespace oc::hal::teensy {
+
+namespace {
+
+/// Page program never crosses a 256-byte flash page
+constexpr size_t FLASH_PAGE_SIZE = 256;
+
+/// Bytes of the header covered by the CRC (everything before the crc field)
+constexpr size_t HEADER_CRC_BYTES = 12;
+
+uint16_t crcUpdate(uint16_t crc, const uint8_t* data, size_t length) {
+    // CRC-16/CCITT-FALSE
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+bool isErased(const uint8_t* data, size_t length) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(data);
+    for (size_t i = 0; i < length / 4; ++i) {
+        if (words[i] != 0xFFFFFFFFu) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+FLASHMEM oc::type::Result<void> JournaledFlashBackend::init() {
+    if (initialized_) return oc::type::Result<void>::ok();
+
+    if (capacity_ == 0 || capacity_ > 0xFFFF || sectorCount_ > REGION_SECTORS ||
+        sectorCount_ < 3 * snapshotSectors()) {
+        return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "Invalid journal geometry"});
+    }
+
+    image_.assign(capacity_, 0xFF);
+    dirty_ = false;
+    scan_();
+    initialized_ = true;
+    return oc::type::Result<void>::ok();
+}
+
+size_t JournaledFlashBackend::read(uint32_t address, uint8_t* buffer, size_t size) {
+    if (!initialized_ || address + size > capacity_) return 0;
+    memcpy(buffer, image_.data() + address, size);
+    return size;
+}
+
+size_t JournaledFlashBackend::write(uint32_t address, const uint8_t* buffer, size_t size) {
+    if (!initialized_ || address + size > capacity_) return 0;
+
+    // Only the changed span becomes dirty (like EEPROM.update)
+    uint8_t* image = image_.data() + address;
+    size_t first = 0;
+    while (first < size && image[first] == buffer[first]) ++first;
+    if (first == size) return size;
+    size_t last = size - 1;
+    while (image[last] == buffer[last]) --last;
+
+    memcpy(image + first, buffer + first, last - first + 1);
+    markDirty_(address + static_cast<uint32_t>(first), last - first + 1);
+    return size;
+}
+
+bool JournaledFlashBackend::erase(uint32_t address, size_t size) {
+    if (!initialized_ || address + size > capacity_) return false;
+
+    uint8_t* image = image_.data() + address;
+    size_t first = 0;
+    while (first < size && image[first] == 0xFF) ++first;
+    if (first == size) return true;
+    size_t last = size - 1;
+    while (image[last] == 0xFF) --last;
+
+    memset(image + first, 0xFF, last - first + 1);
+    markDirty_(address + static_cast<uint32_t>(first), last - first + 1);
+    return true;
+}
+
+bool JournaledFlashBackend::commit() {
+    if (!initialized_) return false;
+    if (!dirty_) return true;
+
+    const size_t length = dirtyEnd_ - dirtyBegin_;
+    bool ok;
+    if (needSnapshot_ || length > MAX_RECORD_DATA) {
+        ok = snapshot_();
+    } else if (fits_(length)) {
+        ok = append_(0, static_cast<uint32_t>(dirtyBegin_), length);
+    } else if (freeSectors_() >= 2 * snapshotSectors()) {
+        // Keep enough free sectors that a snapshot interrupted by power loss
+        // still leaves room for the next one
+        ok = openSector_((headSector_ + 1) % sectorCount_);
+        if (ok) {
+            ++usedSectors_;
+            ok = append_(0, static_cast<uint32_t>(dirtyBegin_), length);
+        }
+    } else {
+        ok = snapshot_();
+    }
+
+    if (ok) dirty_ = false;
+    return ok;
+}
+
+uint16_t JournaledFlashBackend::crc16_(const RecordHeader& header, const uint8_t* data, size_t length) {
+    uint16_t crc = crcUpdate(0xFFFF, reinterpret_cast<const uint8_t*>(&header), HEADER_CRC_BYTES);
+    return crcUpdate(crc, data, length);
+}
+
+bool JournaledFlashBackend::validHeader_(const RecordHeader& header, size_t offset) {
+    return header.magic == RECORD_MAGIC && header.length <= MAX_RECORD_DATA &&
+           offset + recordSize_(header.length) <= FLASH_SECTOR_SIZE;
+}
+
+/**
+ * Two passes over the region: the first finds the newest complete snapshot
+ * and the newest record, the second replays records from that snapshot on,
+ * walking the live sectors in ring order (which is sequence order).
+ */
+FLASHMEM void JournaledFlashBackend::scan_() {
+    uint32_t maxSeq = 0;
+    size_t maxSector = 0;
+    size_t maxEnd = 0;
+    bool anyRecord = false;
+
+    uint32_t baseSeq = 0;
+    uint32_t baseEndSeq = 0;
+    size_t baseSector = 0;
+    bool haveBase = false;
+
+    // Sectors are visited in address order, not ring order, so gather begin
+    // markers first and match each end marker against the newest begin below it
+    std::vector<std::pair<uint32_t, size_t>> begins;
+    std::vector<uint32_t> ends;
+
+    for (size_t sector = 0; sector < sectorCount_; ++sector) {
+        const uint8_t* base = sectorAddress_(sector);
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= FLASH_SECTOR_SIZE) {
+            RecordHeader header;
+            memcpy(&header, base + offset, sizeof(header));
+            if (!validHeader_(header, offset)) break;
+
+            const uint8_t* data = base + offset + HEADER_SIZE;
+            if (crc16_(header, data, header.length) == header.crc) {
+                if (!anyRecord || header.seq > maxSeq) {
+                    maxSeq = header.seq;
+                    maxSector = sector;
+                    maxEnd = offset + recordSize_(header.length);
+                    anyRecord = true;
+                }
+                if ((header.flags & FLAG_SNAPSHOT) && header.address == 0) begins.emplace_back(header.seq, sector);
+                if (header.flags & FLAG_SNAPSHOT_END) ends.push_back(header.seq);
+            }
+            offset += recordSize_(header.length);
+        }
+    }
+
+    for (uint32_t end : ends) {
+        uint32_t lastBeginSeq = 0;
+        size_t lastBeginSector = 0;
+        bool haveBegin = false;
+        for (const auto& begin : begins) {
+            if (begin.first <= end && (!haveBegin || begin.first > lastBeginSeq)) {
+                lastBeginSeq = begin.first;
+                lastBeginSector = begin.second;
+                haveBegin = true;
+            }
+        }
+        if (haveBegin && (!haveBase || end > baseEndSeq)) {
+            baseSeq = lastBeginSeq;
+            baseEndSeq = end;
+            baseSector = lastBeginSector;
+            haveBase = true;
+        }
+    }
+
+    nextSeq_ = anyRecord ? maxSeq + 1 : 1;
+    headSector_ = anyRecord ? maxSector : sectorCount_ - 1;
+    headOffset_ = anyRecord ? maxEnd : FLASH_SECTOR_SIZE;
+    headOpen_ = anyRecord && isErased(sectorAddress_(headSector_) + headOffset_, FLASH_SECTOR_SIZE - headOffset_);
+
+    if (!haveBase) {
+        usedSectors_ = 0;
+        needSnapshot_ = true;
+        return;
+    }
+
+    usedSectors_ = (headSector_ + sectorCount_ - baseSector) % sectorCount_ + 1;
+    needSnapshot_ = false;
+
+    for (size_t i = 0; i < usedSectors_; ++i) {
+        const uint8_t* base = sectorAddress_((baseSector + i) % sectorCount_);
+        size_t offset = 0;
+        while (offset + HEADER_SIZE <= FLASH_SECTOR_SIZE) {
+            RecordHeader header;
+            memcpy(&header, base + offset, sizeof(header));
+            if (!validHeader_(header, offset)) break;
+
+            const uint8_t* data = base + offset + HEADER_SIZE;
+            if (header.seq >= baseSeq && header.address + header.length <= capacity_ &&
+                crc16_(header, data, header.length) == header.crc) {
+                memcpy(image_.data() + header.address, data, header.length);
+            }
+            offset += recordSize_(header.length);
+        }
+    }
+}
+
+size_t JournaledFlashBackend::freeSectors_() const {
+    return sectorCount_ - usedSectors_;
+}
+
+bool JournaledFlashBackend::openSector_(size_t sector) {
+    uint8_t* base = sectorAddress_(sector);
+    if (!isErased(base, FLASH_SECTOR_SIZE)) {
+        eepromemu_flash_erase_sector(base);
+        ++erases_;
+        if (!isErased(base, FLASH_SECTOR_SIZE)) {
+            headOpen_ = false;
+            return false;
+        }
+    }
+    headSector_ = sector;
+    headOffset_ = 0;
+    headOpen_ = true;
+    return true;
+}
+
+bool JournaledFlashBackend::fits_(size_t length) const {
+    return headOpen_ && headOffset_ + recordSize_(length) <= FLASH_SECTOR_SIZE;
+}
+
+/**
+ * Payload first, header last: a record interrupted before its header is
+ * written has no magic, and one interrupted inside the header fails its CRC.
+ */
+bool JournaledFlashBackend::append_(uint8_t flags, uint32_t address, size_t length) {
+    RecordHeader header{};
+    header.magic = RECORD_MAGIC;
+    header.flags = flags;
+    header.reserved = 0xFF;
+    header.address = static_cast<uint16_t>(address);
+    header.length = static_cast<uint16_t>(length);
+    header.seq = nextSeq_;
+    header.pad = 0xFFFF;
+
+    const uint8_t* data = image_.data() + address;
+    header.crc = crc16_(header, data, length);
+
+    uint8_t* dst = sectorAddress_(headSector_) + headOffset_;
+    program_(dst + HEADER_SIZE, data, length);
+    program_(dst, reinterpret_cast<const uint8_t*>(&header), HEADER_SIZE);
+
+    headOffset_ += recordSize_(length);
+    ++nextSeq_;
+    ++records_;
+
+    // A worn or failing sector shows up here; move on to a fresh one next time
+    if (memcmp(dst + HEADER_SIZE, data, length) != 0 || memcmp(dst, &header, HEADER_SIZE) != 0) {
+        headOpen_ = false;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes the whole image, one chunk per fresh sector, right after the head.
+ * The previous snapshot and its records stay intact until the last chunk
+ * (FLAG_SNAPSHOT_END) is on flash, and only then become reclaimable.
+ */
+bool JournaledFlashBackend::snapshot_() {
+    const size_t chunks = snapshotSectors();
+    size_t sector = (headSector_ + 1) % sectorCount_;
+    size_t address = 0;
+
+    for (size_t i = 0; i < chunks; ++i) {
+        if (!openSector_(sector)) return false;
+        ++usedSectors_;
+
+        const size_t remaining = capacity_ - address;
+        const size_t length = remaining < MAX_RECORD_DATA ? remaining : MAX_RECORD_DATA;
+        const uint8_t flags = FLAG_SNAPSHOT | (i + 1 == chunks ? FLAG_SNAPSHOT_END : 0);
+        if (!append_(flags, static_cast<uint32_t>(address), length)) return false;
+
+        address += length;
+        sector = (sector + 1) % sectorCount_;
+    }
+
+    usedSectors_ = chunks;
+    needSnapshot_ = false;
+    return true;
+}
+
+void JournaledFlashBackend::program_(uint8_t* dst, const uint8_t* src, size_t length) {
+    while (length > 0) {
+        const size_t pageRoom = FLASH_PAGE_SIZE - (reinterpret_cast<uintptr_t>(dst) % FLASH_PAGE_SIZE);
+        const size_t chunk = length < pageRoom ? length : pageRoom;
+        eepromemu_flash_write(dst, src, static_cast<uint32_t>(chunk));
+        dst += chunk;
+        src += chunk;
+        length -= chunk;
+    }
+}
+
+void JournaledFlashBackend::markDirty_(uint32_t address, size_t size) {
+    const size_t end = address + size;
+    if (!dirty_) {
+        dirtyBegin_ = address;
+        dirtyEnd_ = end;
+        dirty_ = true;
+        return;
+    }
+    if (address < dirtyBegin_) dirtyBegin_ = address;
+    if (end > dirtyEnd_) dirtyEnd_ = end;
+}
+
+}  // namespace oc::hal::teensy
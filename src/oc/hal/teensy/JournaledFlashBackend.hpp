@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <oc/interface/IStorage.hpp>
+#include <oc/type/Result.hpp>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Log-structured settings storage in the Teensy 4.x EEPROM flash region
+ *
+ * Replaces the byte-wise EEPROM emulation with a journal on the same flash
+ * sectors. write()/erase() only change a RAM image and track a dirty range;
+ * commit() appends that range as one CRC-checked record, so a settings save
+ * is a single program operation instead of one emulated-EEPROM update per
+ * byte. Records fill the sectors round-robin, which spreads erase wear over
+ * the whole region.
+ *
+ * When the free sectors run low, commit() writes a snapshot of the full image
+ * into fresh sectors, after which every older sector is reclaimable. At init()
+ * the image is rebuilt by replaying records from the newest complete snapshot;
+ * records torn by a power loss fail their CRC and are ignored.
+ *
+ * @code
+ * JournaledFlashBackend flash;
+ * flash.init();
+ *
+ * Settings<MySettings> settings(flash, 0x0000, 1);
+ * settings.load();
+ * settings.modify([](auto& s) { s.volume = 0.75f; });
+ * settings.save();
+ * flash.commit();  // One flash record
+ * @endcode
+ *
+ * @note Uses the flash region of the EEPROM library: do not combine with
+ *       EEPROM/EEPROMBackend, and existing EEPROM contents are not migrated.
+ * @note Interrupts are disabled while commit() programs or erases flash.
+ */
+class JournaledFlashBackend : public interface::IStorage {
+public:
+    static constexpr size_t FLASH_SECTOR_SIZE = 4096;
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t MAX_RECORD_DATA = FLASH_SECTOR_SIZE - HEADER_SIZE;
+
+#if defined(ARDUINO_TEENSY40)
+    static constexpr uint32_t REGION_BASE = 0x601F0000;
+    static constexpr size_t REGION_SECTORS = 15;
+#elif defined(ARDUINO_TEENSY41)
+    static constexpr uint32_t REGION_BASE = 0x607C0000;
+    static constexpr size_t REGION_SECTORS = 63;
+#elif defined(ARDUINO_TEENSY_MICROMOD)
+    static constexpr uint32_t REGION_BASE = 0x60FC0000;
+    static constexpr size_t REGION_SECTORS = 63;
+#else
+#error "JournaledFlashBackend requires a Teensy 4.x board"
+#endif
+
+    /**
+     * @brief Construct journaled backend
+     * @param capacity Addressable bytes (default 4KB like EEPROM)
+     * @param sectorCount Flash sectors used from the start of the region;
+     *        needs at least 3 * snapshotSectors()
+     */
+    explicit JournaledFlashBackend(size_t capacity = 4096, size_t sectorCount = REGION_SECTORS)
+        : capacity_(capacity), sectorCount_(sectorCount) {}
+
+    oc::type::Result<void> init() override;
+
+    bool available() const override {
+        return initialized_;
+    }
+
+    size_t read(uint32_t address, uint8_t* buffer, size_t size) override;
+    size_t write(uint32_t address, const uint8_t* buffer, size_t size) override;
+
+    /// Append the dirty range as one record (or a snapshot), no-op when clean
+    bool commit() override;
+
+    bool erase(uint32_t address, size_t size) override;
+
+    size_t capacity() const override {
+        return capacity_;
+    }
+
+    bool isDirty() const override {
+        return dirty_;
+    }
+
+    /// Sectors needed for one full snapshot of the image
+    size_t snapshotSectors() const {
+        return (capacity_ + MAX_RECORD_DATA - 1) / MAX_RECORD_DATA;
+    }
+
+    /// Sector erases performed since init() (wear indicator)
+    uint32_t sectorErases() const { return erases_; }
+
+    /// Records appended since init()
+    uint32_t recordsWritten() const { return records_; }
+
+private:
+    struct RecordHeader {
+        uint16_t magic;
+        uint8_t flags;
+        uint8_t reserved;
+        uint16_t address;
+        uint16_t length;
+        uint32_t seq;
+        uint16_t crc;
+        uint16_t pad;
+    };
+    static_assert(sizeof(RecordHeader) == HEADER_SIZE, "RecordHeader layout");
+
+    static constexpr uint16_t RECORD_MAGIC = 0x4A52;  // "JR"
+    static constexpr uint8_t FLAG_SNAPSHOT = 0x01;
+    static constexpr uint8_t FLAG_SNAPSHOT_END = 0x02;
+
+    uint8_t* sectorAddress_(size_t sector) const {
+        return reinterpret_cast<uint8_t*>(REGION_BASE + sector * FLASH_SECTOR_SIZE);
+    }
+
+    static size_t recordSize_(size_t length) {
+        return HEADER_SIZE + ((length + 3U) & ~size_t{3});
+    }
+
+    static uint16_t crc16_(const RecordHeader& header, const uint8_t* data, size_t length);
+    static bool validHeader_(const RecordHeader& header, size_t offset);
+
+    void scan_();
+    size_t freeSectors_() const;
+    bool openSector_(size_t sector);
+    bool fits_(size_t length) const;
+    bool append_(uint8_t flags, uint32_t address, size_t length);
+    bool snapshot_();
+    void program_(uint8_t* dst, const uint8_t* src, size_t length);
+    void markDirty_(uint32_t address, size_t size);
+
+    size_t capacity_;
+    size_t sectorCount_;
+    std::vector<uint8_t> image_;  // RAM copy of [0, capacity_)
+    size_t dirtyBegin_ = 0;
+    size_t dirtyEnd_ = 0;
+    bool dirty_ = false;
+
+    size_t headSector_ = 0;    // Sector receiving new records
+    size_t headOffset_ = 0;    // Next free byte in headSector_
+    size_t usedSectors_ = 0;   // Live sectors: newest complete snapshot up to headSector_
+    bool headOpen_ = false;    // headSector_ is erased/appendable
+    bool needSnapshot_ = false;  // No complete snapshot on flash yet
+    uint32_t nextSeq_ = 1;
+
+    uint32_t erases_ = 0;
+    uint32_t records_ = 0;
+    bool initialized_ = false;
+};
+
+}  // namespace oc::hal::teensy
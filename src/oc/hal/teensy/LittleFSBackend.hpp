@@ -2,6 +2,9 @@
 
 #include <LittleFS.h>
 
+#include <cstring>
+#include <vector>
+
 #include <oc/interface/IStorage.hpp>
 #include <oc/type/Result.hpp>
 
@@ -13,7 +16,10 @@ namespace oc::hal::teensy {
  * Uses LittleFS_Program (internal flash) with wear leveling.
  * Stores settings in a single file for address-based access.
  *
- * @note All interrupts are disabled during write/erase operations.
+ * The `capacity()` region is mirrored in RAM at init(): read/write/erase only
+ * touch the shadow and track a dirty range, and commit() programs flash.
+ *
+ * @note All interrupts are disabled while commit() programs flash.
  * @note Uploading new code erases the filesystem.
  *
  * Usage:
@@ -22,6 +28,8 @@ namespace oc::hal::teensy {
  * if (flash.init()) {
  *     Settings<MySettings> settings(flash, 0x0000, 1);
  *     settings.load();
+ *     // ... settings.save() ...
+ *     flash.commit();
  * }
  * @endcode
  *
@@ -50,6 +58,7 @@ public:
         }
 
         initialized_ = true;
+        loadShadow_();
         return oc::type::Result<void>::ok();
     }
 
@@ -60,87 +69,61 @@ public:
     size_t read(uint32_t address, uint8_t* buffer, size_t size) override {
         if (!initialized_ || address + size > capacity_) return 0;
 
-        File file = fs_.open(filename_, FILE_READ);
-        if (!file) {
-            // File doesn't exist yet - return zeros (fresh state)
-            memset(buffer, 0xFF, size);
-            return size;
-        }
-
-        if (!file.seek(address)) {
-            file.close();
-            return 0;
-        }
-
-        size_t bytesRead = file.read(buffer, size);
-        file.close();
-
-        // Pad with 0xFF if file is shorter than requested
-        if (bytesRead < size) {
-            memset(buffer + bytesRead, 0xFF, size - bytesRead);
-        }
-
+        memcpy(buffer, shadow_.data() + address, size);
         return size;
     }
 
     size_t write(uint32_t address, const uint8_t* buffer, size_t size) override {
         if (!initialized_ || address + size > capacity_) return 0;
 
-        // Read existing content to preserve data outside write region
-        File file = fs_.open(filename_, FILE_READ);
-        size_t existingSize = file ? file.size() : 0;
-
-        // Create temporary buffer for the region we need
-        // Note: For large files, consider chunked approach
-        uint8_t* temp = nullptr;
-        if (existingSize > 0 && address > 0) {
-            temp = new uint8_t[address];
-            if (temp && file) {
-                file.read(temp, address);
-            }
-        }
-        if (file) file.close();
+        memcpy(shadow_.data() + address, buffer, size);
+        markDirty_(address, size);
+        return size;
+    }
 
-        // Write new content
-        file = fs_.open(filename_, FILE_WRITE);
-        if (!file) {
-            delete[] temp;
-            return 0;
-        }
+    /**
+     * @brief Persist the dirty range of the shadow copy
+     *
+     * This is the only call that touches flash. When the file already spans
+     * the full capacity, only [dirtyBegin, dirtyEnd) is rewritten in place;
+     * otherwise the whole shadow is written once.
+     */
+    bool commit() override {
+        if (!initialized_) return false;
+        if (!dirty_) return true;
 
-        // Write preserved prefix if any
-        if (temp && address > 0) {
-            file.write(temp, address);
-            delete[] temp;
-        } else if (address > 0) {
-            // Pad with 0xFF to reach address
-            for (size_t i = 0; i < address; ++i) {
-                file.write(static_cast<uint8_t>(0xFF));
-            }
+        File file = fs_.open(filename_, FILE_WRITE_BEGIN);
+        if (!file) return false;
+
+        size_t begin = dirtyBegin_;
+        size_t end = dirtyEnd_;
+        if (file.size() < capacity_) {
+            begin = 0;
+            end = capacity_;
         }
 
-        // Write new data
-        size_t written = file.write(buffer, size);
+        bool ok = file.seek(begin);
+        if (ok) {
+            ok = file.write(shadow_.data() + begin, end - begin) == end - begin;
+        }
         file.close();
 
-        return written;
-    }
-
-    bool commit() override {
-        // LittleFS handles this internally
-        return true;
+        if (ok) dirty_ = false;
+        return ok;
     }
 
     bool erase(uint32_t address, size_t size) override {
-        if (!initialized_) return false;
+        if (!initialized_ || address + size > capacity_) return false;
 
-        // Write 0xFF (erased state) to the region
-        uint8_t* eraseBuffer = new uint8_t[size];
-        memset(eraseBuffer, 0xFF, size);
-        size_t result = write(address, eraseBuffer, size);
-        delete[] eraseBuffer;
+        // 0xFF is the erased state
+        memset(shadow_.data() + address, 0xFF, size);
+        markDirty_(address, size);
+        return true;
+    }
 
-        return result == size;
+    /// True when the shadow holds writes not yet committed to flash
+    bool isDirty() const override {
+        return dirty_;
     }
 
     size_t capacity() const override {
@@ -150,9 +133,22 @@ public:
     /**
      * @brief Set the virtual capacity for settings storage
      * @param cap Maximum address space (default 4KB like EEPROM)
+     *
+     * Uncommitted writes below the new capacity are kept for the next commit().
      */
     void setCapacity(size_t cap) {
+        const size_t oldCapacity = capacity_;
         capacity_ = cap;
+        if (!initialized_) return;
+        if (!dirty_) {
+            loadShadow_();
+            return;
+        }
+
+        shadow_.resize(capacity_, 0xFF);
+        if (capacity_ > oldCapacity) readFile_(oldCapacity);
+        if (dirtyEnd_ > capacity_) dirtyEnd_ = capacity_;
+        if (dirtyBegin_ >= dirtyEnd_) dirty_ = false;
     }
 
     /**
@@ -169,14 +165,48 @@ public:
     bool format() {
         if (!initialized_) return false;
         fs_.quickFormat();
+        shadow_.assign(capacity_, 0xFF);
+        dirty_ = false;
         return true;
     }
 
 private:
+    /// Reload the shadow from the file, padding missing bytes with 0xFF
+    void loadShadow_() {
+        shadow_.assign(capacity_, 0xFF);
+        dirty_ = false;
+        readFile_(0);
+    }
+
+    /// Fill shadow_[from, capacity_) from the file; bytes past its end are left as-is
+    void readFile_(size_t from) {
+        File file = fs_.open(filename_, FILE_READ);
+        if (!file) return;
+        if (file.seek(from)) file.read(shadow_.data() + from, capacity_ - from);
+        file.close();
+    }
+
+    void markDirty_(uint32_t address, size_t size) {
+        if (size == 0) return;
+        const size_t end = address + size;
+        if (!dirty_) {
+            dirtyBegin_ = address;
+            dirtyEnd_ = end;
+            dirty_ = true;
+            return;
+        }
+        if (address < dirtyBegin_) dirtyBegin_ = address;
+        if (end > dirtyEnd_) dirtyEnd_ = end;
+    }
+
     LittleFS_Program fs_;
     size_t fsSize_;
     const char* filename_;
     size_t capacity_ = 4096;  // Default 4KB like EEPROM
+    std::vector<uint8_t> shadow_;  // RAM copy of [0, capacity_)
+    size_t dirtyBegin_ = 0;
+    size_t dirtyEnd_ = 0;
+    bool dirty_ = false;
     bool initialized_ = false;
 };
 
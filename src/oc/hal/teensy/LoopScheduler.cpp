@@ -0,0 +1,79 @@
+#include "LoopScheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <oc/log/Log.hpp>
+
+namespace oc::hal::teensy {
+
+FLASHMEM int LoopScheduler::add(const char* name, uint32_t periodUs, uint32_t budgetUs, TaskFn fn) {
+    if (count_ >= tasks_.size() || !fn) return INVALID_TASK;
+
+    Task& task = tasks_[count_];
+    task.name = name;
+    task.periodUs = periodUs;
+    task.budgetUs = budgetUs;
+    task.nextDueUs = clock_.micros64();
+    task.enabled = true;
+    task.fn = std::move(fn);
+    task.stats = {};
+    return static_cast<int>(count_++);
+}
+
+void LoopScheduler::run() {
+    for (size_t i = 0; i < count_; ++i) {
+        Task& task = tasks_[i];
+        if (!task.enabled) continue;
+
+        const uint64_t startUs = clock_.micros64();
+        if (startUs < task.nextDueUs) continue;
+
+        const uint32_t lateUs = static_cast<uint32_t>(startUs - task.nextDueUs);
+        task.fn(task.budgetUs);
+        const uint64_t endUs = clock_.micros64();
+        const uint32_t runUs = static_cast<uint32_t>(endUs - startUs);
+
+        LoopTaskStats& stats = task.stats;
+        ++stats.runs;
+        stats.totalRunUs += runUs;
+        stats.maxRunUs = std::max(stats.maxRunUs, runUs);
+        if (task.periodUs > 0) stats.maxLateUs = std::max(stats.maxLateUs, lateUs);
+        if (task.budgetUs > 0 && runUs > task.budgetUs) ++stats.overruns;
+
+        // Keep the cadence, but skip periods that were missed entirely
+        task.nextDueUs += task.periodUs;
+        if (task.nextDueUs <= endUs) task.nextDueUs = endUs + task.periodUs;
+    }
+}
+
+FLASHMEM void LoopScheduler::setEnabled(int task, bool enabled) {
+    if (task < 0 || static_cast<size_t>(task) >= count_) return;
+    tasks_[task].enabled = enabled;
+    if (enabled) tasks_[task].nextDueUs = clock_.micros64();
+}
+
+FLASHMEM void LoopScheduler::setPeriod(int task, uint32_t periodUs) {
+    if (task < 0 || static_cast<size_t>(task) >= count_) return;
+    tasks_[task].periodUs = periodUs;
+}
+
+FLASHMEM void LoopScheduler::resetStats() {
+    for (size_t i = 0; i < count_; ++i) tasks_[i].stats = {};
+}
+
+FLASHMEM void LoopScheduler::logStats() {
+    for (size_t i = 0; i < count_; ++i) {
+        const Task& task = tasks_[i];
+        const LoopTaskStats& stats = task.stats;
+        const uint32_t avgRunUs =
+            stats.runs > 0 ? static_cast<uint32_t>(stats.totalRunUs / stats.runs) : 0;
+        OC_LOG_INFO("[Perf][Loop] task={} period={}us budget={}us runs={} overruns={} "
+                    "avgRun={}us maxRun={}us maxLate={}us",
+                    task.name, task.periodUs, task.budgetUs, stats.runs, stats.overruns,
+                    avgRunUs, stats.maxRunUs, stats.maxLateUs);
+    }
+    resetStats();
+}
+
+}  // namespace oc::hal::teensy
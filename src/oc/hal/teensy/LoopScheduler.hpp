@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "HighResolutionClock.hpp"
+
+namespace oc::hal::teensy {
+
+/// Per-task counters since the last resetStats()
+struct LoopTaskStats {
+    uint32_t runs = 0;
+    uint32_t overruns = 0;      ///< Runs that took longer than the task budget
+    uint32_t maxRunUs = 0;
+    uint32_t maxLateUs = 0;     ///< Worst start delay past the deadline
+    uint64_t totalRunUs = 0;
+};
+
+/**
+ * @brief Cooperative, rate-based main loop scheduler
+ *
+ * Each task has a period and a time budget. run() starts every task whose
+ * deadline has passed, in registration order (register the latency-critical
+ * ones first), and passes it its budget. Deadlines come from
+ * HighResolutionClock, so periods well below a millisecond work. A task that
+ * falls behind skips the missed periods instead of running in a burst.
+ *
+ * Tasks are not preempted: a long task still delays the others, but they
+ * catch up right after it instead of waiting for a whole update() pass.
+ *
+ * @code
+ * LoopScheduler scheduler;
+ * scheduler.add("midi.out", 250, 200, [&](uint32_t budgetUs) { midi.serviceOutput(budgetUs); });
+ * scheduler.add("ui", 16'666, 0, [&](uint32_t) { lv_timer_handler(); });
+ *
+ * void loop() { scheduler.run(); }
+ * @endcode
+ */
+class LoopScheduler {
+public:
+    static constexpr size_t MAX_TASKS = 12;
+    static constexpr int INVALID_TASK = -1;
+
+    /// Called with the task budget in microseconds (0 = unbounded)
+    using TaskFn = std::function<void(uint32_t budgetUs)>;
+
+    /**
+     * @brief Register a task
+     * @param name Static string used in stats output
+     * @param periodUs Minimum interval between starts (0 = every run())
+     * @param budgetUs Time the task may take per run (0 = unbounded, no overrun tracking)
+     * @return Task index, or INVALID_TASK when the table is full
+     */
+    int add(const char* name, uint32_t periodUs, uint32_t budgetUs, TaskFn fn);
+
+    /// Run every due task once
+    void run();
+
+    void setEnabled(int task, bool enabled);
+    void setPeriod(int task, uint32_t periodUs);
+
+    size_t taskCount() const { return count_; }
+    const char* taskName(size_t task) const { return tasks_[task].name; }
+    const LoopTaskStats& stats(size_t task) const { return tasks_[task].stats; }
+
+    void resetStats();
+
+    /// Log one line per task and reset the counters
+    void logStats();
+
+private:
+    struct Task {
+        const char* name = nullptr;
+        uint32_t periodUs = 0;
+        uint32_t budgetUs = 0;
+        uint64_t nextDueUs = 0;
+        bool enabled = true;
+        TaskFn fn;
+        LoopTaskStats stats{};
+    };
+
+    std::array<Task, MAX_TASKS> tasks_{};
+    size_t count_ = 0;
+    HighResolutionClock clock_{};
+};
+
+}  // namespace oc::hal::teensy
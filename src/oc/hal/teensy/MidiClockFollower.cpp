@@ -0,0 +1,100 @@
+#include "MidiClockFollower.hpp"
+
+namespace oc::hal::teensy {
+
+void MidiClockFollower::onTick(uint64_t timestampUs) {
+    if (start_pending_) {
+        start_pending_ = false;
+        position_ = 0;
+    } else if (ticks_seen_ > 0) {
+        ++position_;
+    }
+
+    if (ticks_seen_ == 0) {
+        restart_(timestampUs);
+        return;
+    }
+
+    const uint64_t rawDelta = timestampUs - last_raw_us_;
+    last_raw_us_ = timestampUs;
+
+    if (ticks_seen_ == 1) {
+        // Second tick: first period estimate, filter starts here
+        period_us_ = static_cast<float>(rawDelta);
+        estimate_us_ = static_cast<double>(timestampUs);
+        ticks_seen_ = 2;
+        return;
+    }
+
+    const double predicted = estimate_us_ + period_us_;
+    const float error = static_cast<float>(static_cast<double>(timestampUs) - predicted);
+    last_error_us_ = static_cast<int32_t>(error);
+
+    const float limit = period_us_ * config_.outlierRatio;
+    if (error > limit || error < -limit) {
+        // Dropped ticks, tempo jump or a stalled host: ignore a few, then relock
+        if (++outliers_ >= config_.maxOutliers) {
+            restart_(timestampUs);
+        } else {
+            estimate_us_ = predicted;
+        }
+        return;
+    }
+
+    outliers_ = 0;
+    estimate_us_ = predicted + config_.alpha * error;
+    period_us_ += config_.beta * error;
+    if (ticks_seen_ < UINT32_MAX) ++ticks_seen_;
+}
+
+void MidiClockFollower::onStart() {
+    start_pending_ = true;
+    position_ = 0;
+}
+
+void MidiClockFollower::reset() {
+    last_raw_us_ = 0;
+    estimate_us_ = 0.0;
+    period_us_ = 0.0f;
+    last_error_us_ = 0;
+    position_ = 0;
+    ticks_seen_ = 0;
+    outliers_ = 0;
+    start_pending_ = false;
+}
+
+bool MidiClockFollower::locked(uint64_t nowUs) const {
+    if (ticks_seen_ < config_.lockTicks || period_us_ <= 0.0f) return false;
+    const float sinceLast = static_cast<float>(nowUs - last_raw_us_);
+    return sinceLast <= period_us_ * config_.timeoutPeriods;
+}
+
+float MidiClockFollower::bpm() const {
+    if (period_us_ <= 0.0f) return 0.0f;
+    return 60000000.0f / (period_us_ * TICKS_PER_QUARTER);
+}
+
+uint64_t MidiClockFollower::predictedTickUs(uint32_t ticksAhead) const {
+    if (ticks_seen_ < 2) return last_raw_us_;
+    return static_cast<uint64_t>(estimate_us_ + static_cast<double>(period_us_) * ticksAhead);
+}
+
+float MidiClockFollower::phase(uint64_t nowUs) const {
+    float fraction = 0.0f;
+    if (ticks_seen_ >= 2 && period_us_ > 0.0f) {
+        fraction = static_cast<float>(static_cast<double>(nowUs) - estimate_us_) / period_us_;
+        if (fraction < 0.0f) fraction = 0.0f;
+        if (fraction > 1.0f) fraction = 1.0f;  // Hold at the next tick until it arrives
+    }
+    return (static_cast<float>(position_ % TICKS_PER_QUARTER) + fraction) / TICKS_PER_QUARTER;
+}
+
+void MidiClockFollower::restart_(uint64_t timestampUs) {
+    last_raw_us_ = timestampUs;
+    estimate_us_ = static_cast<double>(timestampUs);
+    period_us_ = 0.0f;
+    ticks_seen_ = 1;
+    outliers_ = 0;
+}
+
+}  // namespace oc::hal::teensy
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+
+namespace oc::hal::teensy {
+
+struct MidiClockFollowerConfig {
+    /// Phase correction gain per tick (0..1): higher follows jitter, lower smooths it
+    float alpha = 0.125f;
+    /// Period correction gain per tick (0..alpha): higher tracks tempo changes faster
+    float beta = 0.01f;
+    /// Consistent ticks required before locked() reports true
+    uint8_t lockTicks = 24;
+    /// A tick further than this fraction of a period from its prediction is an outlier
+    float outlierRatio = 0.5f;
+    /// Consecutive outliers after which the loop relocks on the new timing
+    uint8_t maxOutliers = 3;
+    /// No tick for this many periods means the clock stopped
+    uint8_t timeoutPeriods = 4;
+};
+
+/**
+ * @brief MIDI clock follower (alpha-beta phase-locked loop)
+ *
+ * Fed with the timestamp of every incoming 24 PPQN clock tick, it keeps a
+ * smoothed tick period and a filtered time for the last tick, so USB jitter
+ * does not show up in the tempo or in predicted tick times. Each tick costs a
+ * handful of float operations, no allocation.
+ *
+ * @code
+ * follower.onTick(timestampUs);
+ * if (follower.locked(nowUs)) {
+ *     scheduleAt(follower.predictedTickUs(6));  // next 16th note
+ * }
+ * @endcode
+ */
+class MidiClockFollower {
+public:
+    static constexpr uint32_t TICKS_PER_QUARTER = 24;
+
+    MidiClockFollower() = default;
+    explicit MidiClockFollower(const MidiClockFollowerConfig& config)
+        : config_(config) {}
+
+    /// Feed one clock tick (microseconds, monotonic)
+    void onTick(uint64_t timestampUs);
+
+    /// MIDI Start: the next tick is tick 0. Tempo estimate is kept.
+    void onStart();
+
+    /// Forget timing and position
+    void reset();
+
+    /// True once the loop has tracked lockTicks consistent ticks and ticks are still arriving
+    bool locked(uint64_t nowUs) const;
+
+    /// Smoothed tempo in BPM, 0 until two ticks have been seen
+    float bpm() const;
+
+    /// Smoothed tick period in microseconds, 0 until two ticks have been seen
+    float periodUs() const { return period_us_; }
+
+    /// Predicted time of the tick `ticksAhead` after the last one (1 = next tick)
+    uint64_t predictedTickUs(uint32_t ticksAhead = 1) const;
+
+    /// Ticks since Start (or since the first tick when no Start was seen)
+    uint32_t tickPosition() const { return position_; }
+
+    /// Position within the current quarter note, 0..1 (interpolated at nowUs)
+    float phase(uint64_t nowUs) const;
+
+    /// Last tick-to-prediction error in microseconds (jitter indicator)
+    int32_t lastErrorUs() const { return last_error_us_; }
+
+private:
+    void restart_(uint64_t timestampUs);
+
+    MidiClockFollowerConfig config_{};
+    uint64_t last_raw_us_ = 0;       // Last tick as received
+    double estimate_us_ = 0.0;       // Filtered time of the last tick
+    float period_us_ = 0.0f;
+    int32_t last_error_us_ = 0;
+    uint32_t position_ = 0;
+    uint32_t ticks_seen_ = 0;        // Since the last (re)lock
+    uint8_t outliers_ = 0;
+    bool start_pending_ = false;
+};
+
+}  // namespace oc::hal::teensy
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <SD.h>
+#include <array>
 #include <cstring>
+#include <vector>
 
 #include <oc/interface/IStorage.hpp>
 #include <oc/log/Log.hpp>
@@ -9,6 +11,14 @@
 
 namespace oc::hal::teensy {
 
+/**
+ * @brief Access mode for SDCardBackend
+ */
+enum class SDCardMode : uint8_t {
+    FILE,         ///< Through the FAT file handle (default)
+    RAW_SECTORS,  ///< Preallocated contiguous file, direct sector I/O
+};
+
 /**
  * @brief SD Card storage backend for Teensy 4.1
  *
@@ -22,8 +32,18 @@ namespace oc::hal::teensy {
  *     --> SDIO ----> SD Card (storage)  <-- Separate bus!
  * ```
  *
- * File handle is kept open for fast read/write access.
- * commit() flushes data to ensure persistence.
+ * File handle is kept open for fast read/write access. Accesses go through
+ * a small LRU cache of 512-byte sectors: repeated reads hit RAM, writes are
+ * merged into cached sectors, and the card only ever sees whole-sector
+ * transfers at sector-aligned offsets. commit() writes back dirty sectors
+ * and flushes data to ensure persistence.
+ *
+ * With SDCardMode::RAW_SECTORS, init() preallocates a contiguous file of
+ * `capacity` bytes (filled with 0xFF on creation) and all I/O goes straight
+ * to its card sectors, bypassing FAT and directory updates. Aligned runs of
+ * two or more whole sectors are transferred as one multi-sector command
+ * instead of through the cache. If the existing file is not contiguous or
+ * cannot be preallocated, the backend falls back to file mode (see isRaw()).
  *
  * Usage:
  * @code
@@ -32,27 +52,35 @@ namespace oc::hal::teensy {
  *     // SD card not inserted or failed
  * }
  *
- * storage.write(0x0000, data, size);  // Direct write via open handle
- * storage.commit();                    // Flush to SD
+ * storage.write(0x0000, data, size);  // Merged into the sector cache
+ * storage.commit();                    // Write back and flush to SD
  * @endcode
  *
  * @note Requires micro SD card in Teensy 4.1 built-in slot
  */
 class SDCardBackend : public interface::IStorage {
 public:
+    /// Cache granularity, matches the SD card sector size
+    static constexpr size_t SECTOR_SIZE = 512;
+
     /**
      * @brief Construct SD card backend
      * @param filename File path on SD card (e.g., "/settings.bin")
      * @param capacity Max addressable size (guard against wild addresses)
+     * @param cacheSectors Number of sectors cached in RAM (min 1)
+     * @param mode File-handle or raw contiguous-sector access
      */
     explicit SDCardBackend(const char* filename = "/settings.bin",
-                           size_t capacity = 1024 * 1024)
-        : filename_(filename), capacity_(capacity) {}
+                           size_t capacity = 1024 * 1024,
+                           size_t cacheSectors = 4,
+                           SDCardMode mode = SDCardMode::FILE)
+        : filename_(filename), capacity_(capacity),
+          cache_(cacheSectors > 0 ? cacheSectors : 1), mode_(mode) {}
 
     ~SDCardBackend() {
-        if (file_) {
-            file_.close();
-        }
+        if (ready_()) writeBackAll_();
+        if (card_) card_->syncDevice();
+        if (file_) file_.close();
     }
 
     /**
@@ -67,11 +95,18 @@ public:
             return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "SD.begin() failed"});
         }
 
-        // Open with read+write, create if needed
-        file_ = SD.open(filename_, FILE_WRITE);
-        if (!file_) {
-            OC_LOG_ERROR("[SDCard] Failed to open {}", filename_);
-            return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "Failed to open file"});
+        if (mode_ == SDCardMode::RAW_SECTORS && !openRaw_()) {
+            OC_LOG_WARN("[SDCard] {} is not contiguous, using file mode", filename_);
+        }
+
+        if (!card_) {
+            // Open with read+write, create if needed
+            file_ = SD.open(filename_, FILE_WRITE);
+            if (!file_) {
+                OC_LOG_ERROR("[SDCard] Failed to open {}", filename_);
+                return oc::type::Result<void>::err({oc::type::ErrorCode::HARDWARE_INIT_FAILED, "Failed to open file"});
+            }
+            fileSize_ = file_.size();
         }
 
         initialized_ = true;
@@ -83,63 +118,52 @@ public:
     }
 
     size_t read(uint32_t address, uint8_t* buffer, size_t size) override {
-        if (!file_ || address + size > capacity_) return 0;
+        if (!ready_() || address + size > capacity_) return 0;
 
-        size_t fileSize = file_.size();
-        if (address >= fileSize) {
-            std::memset(buffer, 0xFF, size);
-            return size;
-        }
+        const size_t total = size;
+        while (size > 0) {
+            const size_t run = bulkSectors_(address, size);
+            if (run > 0) {
+                if (!readBulk_(address / SECTOR_SIZE, buffer, run)) return 0;
+                const size_t bytes = run * SECTOR_SIZE;
+                buffer += bytes;
+                address += static_cast<uint32_t>(bytes);
+                size -= bytes;
+                continue;
+            }
 
-        file_.seek(address);
-        size_t bytesRead = file_.read(buffer, size);
+            Sector* sector = acquire_(address / SECTOR_SIZE);
+            if (!sector) return 0;
 
-        // Pad with 0xFF if file is shorter than requested
-        if (bytesRead < size) {
-            std::memset(buffer + bytesRead, 0xFF, size - bytesRead);
+            const size_t offset = address % SECTOR_SIZE;
+            const size_t chunk = (SECTOR_SIZE - offset < size) ? SECTOR_SIZE - offset : size;
+            std::memcpy(buffer, sector->data.data() + offset, chunk);
+            buffer += chunk;
+            address += static_cast<uint32_t>(chunk);
+            size -= chunk;
         }
-
-        return size;
+        return total;
     }
 
     size_t write(uint32_t address, const uint8_t* buffer, size_t size) override {
-        if (!file_ || address + size > capacity_) return 0;
-
-        // Pad with 0xFF if writing beyond current file size
-        size_t fileSize = file_.size();
-        if (address > fileSize) {
-            file_.seek(fileSize);
-            size_t gap = address - fileSize;
-            while (gap > 0) {
-                size_t chunk = (gap > sizeof(PADDING)) ? sizeof(PADDING) : gap;
-                file_.write(PADDING, chunk);
-                gap -= chunk;
-            }
-        }
-
-        file_.seek(address);
-        return file_.write(buffer, size);
+        if (!ready_() || address + size > capacity_) return 0;
+        return store_(address, buffer, size) ? size : 0;
     }
 
     bool commit() override {
-        if (!file_) return false;
-        file_.flush();
-        return true;
+        if (!ready_()) return false;
+        bool ok = writeBackAll_();
+        if (card_) {
+            ok = card_->syncDevice() && ok;
+        } else {
+            file_.flush();
+        }
+        return ok;
     }
 
     bool erase(uint32_t address, size_t size) override {
-        if (!file_ || address + size > capacity_) return false;
-
-        file_.seek(address);
-        size_t remaining = size;
-        while (remaining > 0) {
-            size_t chunk = (remaining > sizeof(PADDING)) ? sizeof(PADDING) : remaining;
-            if (file_.write(PADDING, chunk) != chunk) {
-                return false;
-            }
-            remaining -= chunk;
-        }
-        return true;
+        if (!ready_() || address + size > capacity_) return false;
+        return store_(address, nullptr, size);
     }
 
     size_t capacity() const override {
@@ -147,19 +171,262 @@ public:
     }
 
     bool isDirty() const override {
-        return false;  // No tracking, caller should commit() when needed
+        for (const Sector& sector : cache_) {
+            if (sector.valid && sector.dirty) return true;
+        }
+        return false;
     }
 
     /**
      * @brief Close and reopen file (for SD card hot-swap recovery)
+     *
+     * Dirty cached sectors are written back first while the handle still
+     * works; whatever could not be written is dropped with the rest of the
+     * cache, which may describe another card after a swap.
      */
     bool reopen() {
+        if (ready_() && writeBackAll_() && card_) card_->syncDevice();
         if (file_) file_.close();
+        card_ = nullptr;
+        for (Sector& sector : cache_) {
+            sector.valid = false;
+            sector.dirty = false;
+        }
+        if (mode_ == SDCardMode::RAW_SECTORS && openRaw_()) return true;
+
         file_ = SD.open(filename_, FILE_WRITE);
+        fileSize_ = file_ ? file_.size() : 0;
         return static_cast<bool>(file_);
     }
 
+    /// True when I/O goes directly to the preallocated sectors
+    bool isRaw() const { return card_ != nullptr; }
+
+    /// Cache hit/miss counters since construction
+    uint32_t cacheHits() const { return hits_; }
+    uint32_t cacheMisses() const { return misses_; }
+
 private:
+    struct Sector {
+        uint32_t index = 0;
+        uint32_t lastUse = 0;
+        bool valid = false;
+        bool dirty = false;
+        std::array<uint8_t, SECTOR_SIZE> data{};
+    };
+
+    /// Copy data (or 0xFF when nullptr) into cached sectors and mark them dirty
+    bool store_(uint32_t address, const uint8_t* data, size_t size) {
+        while (size > 0) {
+            const size_t run = data ? bulkSectors_(address, size) : 0;
+            if (run > 0) {
+                if (!writeBulk_(address / SECTOR_SIZE, data, run)) return false;
+                const size_t bytes = run * SECTOR_SIZE;
+                data += bytes;
+                address += static_cast<uint32_t>(bytes);
+                size -= bytes;
+                continue;
+            }
+
+            Sector* sector = acquire_(address / SECTOR_SIZE);
+            if (!sector) return false;
+
+            const size_t offset = address % SECTOR_SIZE;
+            const size_t chunk = (SECTOR_SIZE - offset < size) ? SECTOR_SIZE - offset : size;
+            if (data) {
+                std::memcpy(sector->data.data() + offset, data, chunk);
+                data += chunk;
+            } else {
+                std::memset(sector->data.data() + offset, 0xFF, chunk);
+            }
+            sector->dirty = true;
+            address += static_cast<uint32_t>(chunk);
+            size -= chunk;
+        }
+        return true;
+    }
+
+    /// Return the cached sector, evicting the least recently used one on a miss
+    Sector* acquire_(uint32_t index) {
+        Sector* victim = &cache_[0];
+        for (Sector& sector : cache_) {
+            if (sector.valid && sector.index == index) {
+                sector.lastUse = ++useClock_;
+                ++hits_;
+                return &sector;
+            }
+            if (!sector.valid) {
+                if (victim->valid) victim = &sector;
+            } else if (victim->valid && sector.lastUse < victim->lastUse) {
+                victim = &sector;
+            }
+        }
+
+        ++misses_;
+        if (victim->valid && victim->dirty && !writeBack_(*victim)) return nullptr;
+
+        if (!load_(index, *victim)) {
+            victim->valid = false;
+            return nullptr;
+        }
+        victim->index = index;
+        victim->valid = true;
+        victim->dirty = false;
+        victim->lastUse = ++useClock_;
+        return victim;
+    }
+
+    bool ready_() const { return card_ != nullptr || static_cast<bool>(file_); }
+
+    /**
+     * @brief Map the file onto a contiguous sector range, creating it if needed
+     *
+     * A new (empty) file is preallocated to `capacity_` and filled with 0xFF;
+     * an existing file is used only if it is large enough and contiguous.
+     */
+    bool openRaw_() {
+        SdCard* card = SD.sdfs.card();
+        if (!card) return false;
+
+        FsFile file = SD.sdfs.open(filename_, O_RDWR | O_CREAT);
+        if (!file) return false;
+
+        bool fresh = false;
+        if (file.fileSize() == 0) {
+            const size_t rounded = (capacity_ + SECTOR_SIZE - 1) / SECTOR_SIZE * SECTOR_SIZE;
+            if (!file.preAllocate(rounded)) {
+                file.close();
+                return false;
+            }
+            fresh = true;
+        }
+
+        uint32_t first = 0;
+        uint32_t last = 0;
+        const bool mapped = file.fileSize() >= capacity_ && file.contiguousRange(&first, &last) &&
+                            (static_cast<size_t>(last - first) + 1U) * SECTOR_SIZE >= capacity_;
+        file.close();  // Directory entry is final, the sectors stay ours
+        if (!mapped) return false;
+
+        card_ = card;
+        firstSector_ = first;
+        fileSize_ = capacity_;
+
+        if (fresh && !fillRaw_()) {
+            card_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /// Fill the whole raw region with the erased value (new files only)
+    bool fillRaw_() {
+        // The cache is empty at this point; borrow one slot as the 0xFF source
+        Sector& scratch = cache_[0];
+        scratch.valid = false;
+        scratch.data.fill(0xFF);
+
+        const size_t sectors = (capacity_ + SECTOR_SIZE - 1) / SECTOR_SIZE;
+        for (size_t i = 0; i < sectors; ++i) {
+            if (!card_->writeSectors(firstSector_ + i, scratch.data.data(), 1)) return false;
+        }
+        return card_->syncDevice();
+    }
+
+    /// Whole sectors at address eligible for a direct multi-sector transfer
+    size_t bulkSectors_(uint32_t address, size_t size) const {
+        if (!card_ || (address % SECTOR_SIZE) != 0) return 0;
+        const size_t count = size / SECTOR_SIZE;
+        return count >= 2 ? count : 0;
+    }
+
+    /// Direct read, then overlay cached sectors (they are never older than the card)
+    bool readBulk_(uint32_t index, uint8_t* buffer, size_t count) {
+        if (!card_->readSectors(firstSector_ + index, buffer, count)) return false;
+        for (const Sector& sector : cache_) {
+            if (!sector.valid || sector.index < index || sector.index >= index + count) continue;
+            std::memcpy(buffer + (sector.index - index) * SECTOR_SIZE, sector.data.data(), SECTOR_SIZE);
+        }
+        return true;
+    }
+
+    /// Direct write; cached copies of the same sectors are refreshed and clean
+    bool writeBulk_(uint32_t index, const uint8_t* buffer, size_t count) {
+        if (!card_->writeSectors(firstSector_ + index, buffer, count)) return false;
+        for (Sector& sector : cache_) {
+            if (!sector.valid || sector.index < index || sector.index >= index + count) continue;
+            std::memcpy(sector.data.data(), buffer + (sector.index - index) * SECTOR_SIZE, SECTOR_SIZE);
+            sector.dirty = false;
+        }
+        return true;
+    }
+
+    bool load_(uint32_t index, Sector& sector) {
+        if (card_) return card_->readSectors(firstSector_ + index, sector.data.data(), 1);
+
+        const size_t start = static_cast<size_t>(index) * SECTOR_SIZE;
+        if (start >= fileSize_) {
+            sector.data.fill(0xFF);
+            return true;
+        }
+
+        if (!file_.seek(start)) return false;
+        const size_t bytesRead = file_.read(sector.data.data(), SECTOR_SIZE);
+
+        // Pad with 0xFF if file is shorter than the sector
+        if (bytesRead < SECTOR_SIZE) {
+            std::memset(sector.data.data() + bytesRead, 0xFF, SECTOR_SIZE - bytesRead);
+        }
+        return true;
+    }
+
+    bool writeBack_(Sector& sector) {
+        if (card_) {
+            if (!card_->writeSectors(firstSector_ + sector.index, sector.data.data(), 1)) return false;
+            sector.dirty = false;
+            return true;
+        }
+
+        const size_t start = static_cast<size_t>(sector.index) * SECTOR_SIZE;
+
+        // Pad with 0xFF if writing beyond current file size
+        if (start > fileSize_) {
+            file_.seek(fileSize_);
+            size_t gap = start - fileSize_;
+            while (gap > 0) {
+                size_t chunk = (gap > sizeof(PADDING)) ? sizeof(PADDING) : gap;
+                if (file_.write(PADDING, chunk) != chunk) return false;
+                gap -= chunk;
+            }
+        }
+
+        const size_t length = (start + SECTOR_SIZE <= capacity_) ? SECTOR_SIZE : capacity_ - start;
+        if (!file_.seek(start) || file_.write(sector.data.data(), length) != length) return false;
+
+        if (start + length > fileSize_) fileSize_ = start + length;
+        sector.dirty = false;
+        return true;
+    }
+
+    /// Write back every dirty sector in ascending order (sequential on the card)
+    bool writeBackAll_() {
+        bool ok = true;
+        for (;;) {
+            Sector* next = nullptr;
+            for (Sector& sector : cache_) {
+                if (!sector.valid || !sector.dirty) continue;
+                if (!next || sector.index < next->index) next = &sector;
+            }
+            if (!next) break;
+            if (!writeBack_(*next)) {
+                ok = false;
+                next->dirty = false;  // Give up on this sector rather than loop forever
+                next->valid = false;
+            }
+        }
+        return ok;
+    }
+
     static constexpr uint8_t PADDING[64] = {
         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
         0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
@@ -174,6 +441,14 @@ private:
     const char* filename_;
     size_t capacity_;
     File file_;  // Persistent handle - avoids open/close overhead
+    SdCard* card_ = nullptr;  // Set in raw mode only
+    uint32_t firstSector_ = 0;
+    size_t fileSize_ = 0;  // Tracked locally, no size() query per access
+    std::vector<Sector> cache_;
+    uint32_t useClock_ = 0;
+    uint32_t hits_ = 0;
+    uint32_t misses_ = 0;
+    SDCardMode mode_;
     bool initialized_ = false;
 };
 
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file ScheduledDrivers.hpp
+ * @brief Driver wrappers whose service steps belong to a LoopScheduler
+ *
+ * OpenControlApp::update() services every driver it owns on each call. When
+ * AppBuilder::scheduler() is used, the app receives these wrappers instead:
+ * they forward the whole driver API but turn the update()/service entry
+ * points into no-ops, so the scheduler tasks holding driver() are the only
+ * place the drivers run, each at its own rate. app->update() is left with
+ * the contexts, the UI and the display flush.
+ */
+
+#include <memory>
+#include <utility>
+
+#include <oc/interface/IButton.hpp>
+#include <oc/interface/IEncoder.hpp>
+#include <oc/interface/IMidi.hpp>
+#include <oc/interface/ITransport.hpp>
+#include <oc/type/Result.hpp>
+
+namespace oc::hal::teensy {
+
+/// IMidi with pollInput()/serviceOutput() left to the scheduler
+class ScheduledMidi : public interface::IMidi {
+public:
+    explicit ScheduledMidi(std::unique_ptr<interface::IMidi> midi) : midi_(std::move(midi)) {}
+
+    interface::IMidi& driver() { return *midi_; }
+
+    oc::type::Result<void> init() override { return midi_->init(); }
+    void update() override {}
+    void pollInput() override {}
+    void serviceOutput() override {}
+    void serviceOutput(uint32_t) override {}
+
+    void sendCC(uint8_t channel, uint8_t cc, uint8_t value) override { midi_->sendCC(channel, cc, value); }
+    void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) override {
+        midi_->sendNoteOn(channel, note, velocity);
+    }
+    void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) override {
+        midi_->sendNoteOff(channel, note, velocity);
+    }
+    void sendSysEx(const uint8_t* data, size_t length) override { midi_->sendSysEx(data, length); }
+    void sendProgramChange(uint8_t channel, uint8_t program) override {
+        midi_->sendProgramChange(channel, program);
+    }
+    void sendPitchBend(uint8_t channel, int16_t value) override { midi_->sendPitchBend(channel, value); }
+    void sendChannelPressure(uint8_t channel, uint8_t pressure) override {
+        midi_->sendChannelPressure(channel, pressure);
+    }
+    void sendClock() override { midi_->sendClock(); }
+    void sendStart() override { midi_->sendStart(); }
+    void sendStop() override { midi_->sendStop(); }
+    void sendContinue() override { midi_->sendContinue(); }
+    void allNotesOff() override { midi_->allNotesOff(); }
+
+    void setOnCC(CCCallback cb) override { midi_->setOnCC(std::move(cb)); }
+    void setOnNoteOn(NoteCallback cb) override { midi_->setOnNoteOn(std::move(cb)); }
+    void setOnNoteOff(NoteCallback cb) override { midi_->setOnNoteOff(std::move(cb)); }
+    void setOnSysEx(SysExCallback cb) override { midi_->setOnSysEx(std::move(cb)); }
+    void setOnClock(ClockCallback cb) override { midi_->setOnClock(std::move(cb)); }
+    void setOnStart(RealtimeCallback cb) override { midi_->setOnStart(std::move(cb)); }
+    void setOnStop(RealtimeCallback cb) override { midi_->setOnStop(std::move(cb)); }
+    void setOnContinue(RealtimeCallback cb) override { midi_->setOnContinue(std::move(cb)); }
+
+private:
+    std::unique_ptr<interface::IMidi> midi_;
+};
+
+/// ITransport with update() left to the scheduler
+class ScheduledTransport : public interface::ITransport {
+public:
+    explicit ScheduledTransport(std::unique_ptr<interface::ITransport> transport)
+        : transport_(std::move(transport)) {}
+
+    interface::ITransport& driver() { return *transport_; }
+
+    oc::type::Result<void> init() override { return transport_->init(); }
+    void update() override {}
+    void send(const uint8_t* data, size_t length) override { transport_->send(data, length); }
+    void setOnReceive(ReceiveCallback cb) override { transport_->setOnReceive(std::move(cb)); }
+
+private:
+    std::unique_ptr<interface::ITransport> transport_;
+};
+
+/// IButton with update() left to the scheduler
+class ScheduledButtons : public interface::IButton {
+public:
+    explicit ScheduledButtons(std::unique_ptr<interface::IButton> buttons)
+        : buttons_(std::move(buttons)) {}
+
+    interface::IButton& driver() { return *buttons_; }
+
+    oc::type::Result<void> init() override { return buttons_->init(); }
+    void update(uint32_t) override {}
+    bool isPressed(oc::type::ButtonID id) const override { return buttons_->isPressed(id); }
+    void setCallback(oc::type::ButtonCallback cb) override { buttons_->setCallback(std::move(cb)); }
+
+private:
+    std::unique_ptr<interface::IButton> buttons_;
+};
+
+/// IEncoder with update() left to the scheduler
+class ScheduledEncoders : public interface::IEncoder {
+public:
+    explicit ScheduledEncoders(std::unique_ptr<interface::IEncoder> encoders)
+        : encoders_(std::move(encoders)) {}
+
+    interface::IEncoder& driver() { return *encoders_; }
+
+    oc::type::Result<void> init() override { return encoders_->init(); }
+    void update() override {}
+    float getPosition(oc::type::EncoderID id) const override { return encoders_->getPosition(id); }
+    void setPosition(oc::type::EncoderID id, float value) override { encoders_->setPosition(id, value); }
+    void setMode(oc::type::EncoderID id, interface::EncoderMode mode) override {
+        encoders_->setMode(id, mode);
+    }
+    void setBounds(oc::type::EncoderID id, float min, float max) override {
+        encoders_->setBounds(id, min, max);
+    }
+    void setDiscreteSteps(oc::type::EncoderID id, uint8_t steps) override {
+        encoders_->setDiscreteSteps(id, steps);
+    }
+    void setDiscreteTicksPerStep(oc::type::EncoderID id, uint16_t ticksPerStep) override {
+        encoders_->setDiscreteTicksPerStep(id, ticksPerStep);
+    }
+    void setNormalizedTurns(oc::type::EncoderID id, float turns) override {
+        encoders_->setNormalizedTurns(id, turns);
+    }
+    void setContinuous(oc::type::EncoderID id) override { encoders_->setContinuous(id); }
+    void setDelta(oc::type::EncoderID id, float delta) override { encoders_->setDelta(id, delta); }
+    void setCallback(oc::type::EncoderCallback cb) override { encoders_->setCallback(std::move(cb)); }
+
+private:
+    std::unique_ptr<interface::IEncoder> encoders_;
+};
+
+}  // namespace oc::hal::teensy
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Contiguous FIFO byte allocator over a caller-owned buffer
+ *
+ * The producer carves variable-length contiguous blocks, the consumer frees
+ * them in the same order. Block offsets and lengths travel alongside (e.g. in
+ * an SpscRing of descriptors), so the arena itself only tracks two cursors:
+ * the write cursor is producer-owned, the read cursor consumer-owned. A block
+ * that would straddle the end of the buffer wraps to offset 0 and the tail
+ * gap is reclaimed when the consumer moves past it. An empty arena always
+ * takes a block of up to maxBlockSize() bytes.
+ *
+ * @code
+ * uint32_t offset = 0;
+ * if (uint8_t* dst = arena.allocate(length, offset)) {
+ *     memcpy(dst, data, length);
+ *     descriptors.push({offset, length});
+ * }
+ * // consumer, after using the block:
+ * arena.release(offset, length);
+ * @endcode
+ */
+class SpscByteArena {
+public:
+    SpscByteArena() = default;
+    SpscByteArena(uint8_t* buffer, size_t capacity) { reset(buffer, capacity); }
+
+    /// Attach storage; only valid while no block is outstanding
+    void reset(uint8_t* buffer, size_t capacity) {
+        buffer_ = buffer;
+        capacity_ = static_cast<uint32_t>(capacity);
+        write_ = 0;
+        read_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Largest block that can ever be allocated
+    size_t maxBlockSize() const { return capacity_ > 0 ? capacity_ - 1U : 0; }
+
+    /// Producer side: reserve length contiguous bytes, nullptr when full
+    uint8_t* allocate(size_t length, uint32_t& offset) {
+        if (length == 0 || length > maxBlockSize()) return nullptr;
+
+        const uint32_t size = static_cast<uint32_t>(length);
+        uint32_t read = read_.load(std::memory_order_acquire);
+        uint32_t write = write_;
+
+        // Empty with both cursors mid-buffer: rewind so any block up to
+        // maxBlockSize() fits. Nothing is outstanding, so the consumer does not
+        // touch the read cursor again until the next block is published.
+        if (write == read && write != 0) {
+            read_.store(0, std::memory_order_relaxed);
+            write_ = 0;
+            read = write = 0;
+        }
+
+        // write == read always means empty: the write cursor never catches up
+        // with the read cursor from behind.
+        if (write >= read) {
+            if (write + size < capacity_ || (write + size == capacity_ && read > 0)) {
+                offset = write;
+            } else if (size < read) {
+                offset = 0;
+            } else {
+                return nullptr;
+            }
+        } else if (write + size < read) {
+            offset = write;
+        } else {
+            return nullptr;
+        }
+
+        const uint32_t next = offset + size;
+        write_ = (next == capacity_) ? 0 : next;
+        return buffer_ + offset;
+    }
+
+    /// Consumer side: free the oldest outstanding block
+    void release(uint32_t offset, size_t length) {
+        const uint32_t next = offset + static_cast<uint32_t>(length);
+        read_.store(next == capacity_ ? 0 : next, std::memory_order_release);
+    }
+
+    const uint8_t* data(uint32_t offset) const { return buffer_ + offset; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    uint8_t* buffer_ = nullptr;
+    uint32_t capacity_ = 0;
+    uint32_t write_ = 0;                // Producer-owned
+    std::atomic<uint32_t> read_{0};     // Consumer-owned
+};
+
+}  // namespace oc::hal::teensy
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Lock-free single-producer / single-consumer ring buffer
+ *
+ * Exactly one context may push and exactly one context may pop; neither side
+ * masks interrupts. Head and tail are free-running 32-bit counters, so all
+ * `Capacity` slots are usable, and each lives on its own cache line so the
+ * producer and the consumer never write to the same line.
+ *
+ * @tparam T Trivially copyable element type
+ * @tparam Capacity Number of slots (power of two)
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    /// Cortex-M7 L1 data cache line size
+    static constexpr size_t CACHE_LINE_BYTES = 32;
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    /// Producer side: append one element, false when full
+    bool push(const T& value) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        const uint32_t head = head_.load(std::memory_order_acquire);
+        if (tail - head >= Capacity) return false;
+
+        slots_[tail & MASK] = value;
+        tail_.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side: remove one element, false when empty
+    bool pop(T& value) { return popBulk(&value, 1) == 1; }
+
+    /// Consumer side: remove up to maxCount elements in FIFO order
+    size_t popBulk(T* out, size_t maxCount) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const uint32_t tail = tail_.load(std::memory_order_acquire);
+        size_t count = tail - head;
+        if (count > maxCount) count = maxCount;
+
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = slots_[(head + i) & MASK];
+        }
+        head_.store(head + static_cast<uint32_t>(count), std::memory_order_release);
+        return count;
+    }
+
+    /// Consumer side: drop everything currently queued
+    void clear() {
+        head_.store(tail_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /// Number of queued elements (exact from either side, a snapshot otherwise)
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    static constexpr uint32_t MASK = static_cast<uint32_t>(Capacity - 1);
+
+    alignas(CACHE_LINE_BYTES) std::atomic<uint32_t> head_{0};  // Written by consumer
+    alignas(CACHE_LINE_BYTES) std::atomic<uint32_t> tail_{0};  // Written by producer
+    alignas(CACHE_LINE_BYTES) std::array<T, Capacity> slots_{};
+};
+
+}  // namespace oc::hal::teensy
@@ -61,6 +61,7 @@ auto makeEncoderController(const std::array<embedded::EncoderDef, N>& defs) {
 /**
  * @brief Create a button controller with default GPIO
  *
+ * @tparam Debouncer Debouncer template (TimeDebouncer or VerticalCounterDebouncer)
  * @tparam N Number of buttons
  * @param defs Button definitions
  * @param mux Optional multiplexer for muxed buttons
@@ -71,12 +72,12 @@ auto makeEncoderController(const std::array<embedded::EncoderDef, N>& defs) {
  * auto buttons = teensy::makeButtonController(Config::Btn::ALL);
  * @endcode
  */
-template <size_t N>
+template <template <size_t> class Debouncer = TimeDebouncer, size_t N>
 auto makeButtonController(
     const std::array<embedded::ButtonDef, N>& defs,
     interface::IMultiplexer* mux = nullptr,
     uint8_t debounceMs = 5) {
-    return std::make_unique<ButtonController<N>>(defs, gpio(), mux, debounceMs);
+    return std::make_unique<ButtonController<N, Debouncer<N>>>(defs, gpio(), mux, debounceMs);
 }
 
 /**
@@ -2,6 +2,8 @@
 
 #include <Arduino.h>
 
+#include <array>
+
 #include <oc/interface/IGpio.hpp>
 
 namespace oc::hal::teensy {
@@ -40,4 +42,95 @@ inline TeensyGpio& gpio() {
     return instance;
 }
 
+/**
+ * @brief Read the whole input (PSR) register of the GPIO port holding pin
+ *
+ * Test individual pins against digitalPinToBitMask(pin).
+ */
+inline uint32_t readPort(uint8_t pin) {
+    return *portInputRegister(pin);
+}
+
+/**
+ * @brief Pin input resolved to its port register and bit mask once
+ *
+ * Equivalent to digitalReadFast() for pins only known at runtime: one
+ * register load and a mask test, no pin table lookup per read.
+ */
+struct FastPin {
+    volatile uint32_t* input = nullptr;
+    uint32_t mask = 0;
+
+    static FastPin of(uint8_t pin) {
+        return {portInputRegister(pin), digitalPinToBitMask(pin)};
+    }
+
+    bool read() const { return (*input & mask) != 0; }
+};
+
+/**
+ * @brief Pin fixed at compile time (digitalReadFast / digitalWriteFast)
+ */
+template <uint8_t Pin>
+struct StaticPin {
+    static bool read() { return digitalReadFast(Pin); }
+    static void write(bool high) { digitalWriteFast(Pin, high ? HIGH : LOW); }
+    static void toggle() { digitalToggleFast(Pin); }
+};
+
+/**
+ * @brief Sample many input pins with one read per GPIO port
+ *
+ * Pins are grouped by port at setup; sample() snapshots each distinct port
+ * register once (at most four on Teensy 4.x), then read() is a mask test on
+ * the snapshot. All pins are sampled at the same instant.
+ *
+ * @tparam N Number of slots
+ */
+template <size_t N>
+class FastPinGroup {
+public:
+    static constexpr size_t MAX_PORTS = 4;
+
+    FastPinGroup() { port_.fill(UNUSED); }
+
+    /// Assign pin to slot, false if the pins span more than MAX_PORTS ports
+    bool set(size_t slot, uint8_t pin) {
+        if (slot >= N) return false;
+        volatile uint32_t* input = portInputRegister(pin);
+
+        uint8_t index = 0;
+        while (index < portCount_ && ports_[index] != input) ++index;
+        if (index == portCount_) {
+            if (portCount_ == MAX_PORTS) return false;
+            ports_[portCount_++] = input;
+        }
+        port_[slot] = index;
+        mask_[slot] = digitalPinToBitMask(pin);
+        return true;
+    }
+
+    void sample() {
+        for (uint8_t i = 0; i < portCount_; ++i) {
+            snapshot_[i] = *ports_[i];
+        }
+    }
+
+    /// Level of slot at the last sample(); unassigned slots read low
+    bool read(size_t slot) const {
+        return port_[slot] != UNUSED && (snapshot_[port_[slot]] & mask_[slot]) != 0;
+    }
+
+    size_t portCount() const { return portCount_; }
+
+private:
+    static constexpr uint8_t UNUSED = 0xFF;
+
+    std::array<volatile uint32_t*, MAX_PORTS> ports_{};
+    std::array<uint32_t, MAX_PORTS> snapshot_{};
+    std::array<uint8_t, N> port_{};
+    std::array<uint32_t, N> mask_{};
+    uint8_t portCount_ = 0;
+};
+
 }  // namespace oc::hal::teensy
@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+ * @file Telemetry.hpp
+ * @brief Binary performance telemetry over a frame transport
+ *
+ * Drivers fill fixed-layout little-endian records and push them as single
+ * frames through an ITransport (UsbSerial: one COBS frame per record), so a
+ * host tool can decode them with a plain struct unpack instead of parsing
+ * log text. Every record starts with a TelemetryHeader; `size` covers the
+ * whole record, so hosts can skip types or versions they do not know.
+ *
+ * @code
+ * UsbSerial serial;
+ * TelemetryChannel telemetry(serial, 500);
+ * midi.setTelemetry(&telemetry);
+ * display.setTelemetry(&telemetry);
+ * @endcode
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include <oc/interface/ITransport.hpp>
+
+namespace oc::hal::teensy {
+
+enum class TelemetryType : uint8_t {
+    DISPLAY_PERF = 1,   ///< TelemetryDisplayPerf
+    MIDI_OUTPUT = 2,    ///< TelemetryMidiOutput
+    COUNT
+};
+
+struct __attribute__((packed)) TelemetryHeader {
+    static constexpr uint16_t MAGIC = 0x544F;  ///< "OT" on the wire
+
+    uint16_t magic = MAGIC;
+    uint8_t type = 0;
+    uint8_t version = 0;
+    uint16_t size = 0;          ///< Whole record in bytes, header included
+    uint32_t timestampMs = 0;
+};
+
+/// Ili9341::PerfSnapshot, one window (stats are reset after each record)
+struct __attribute__((packed)) TelemetryDisplayPerf {
+    static constexpr TelemetryType TYPE = TelemetryType::DISPLAY_PERF;
+    static constexpr uint8_t VERSION = 1;
+
+    TelemetryHeader header;
+    uint32_t frames;
+    uint32_t currentFps;
+    float averageFps;
+    float uploadRateFps;
+    float diffSpeedUp;
+    float pixelsRatio;
+    uint32_t tearedFrames;
+    float tearRatio;
+    float cpuTimeAvgUs;
+    int32_t cpuTimeMaxUs;
+    float uploadTimeAvgUs;
+    int32_t uploadTimeMaxUs;
+    float pixelsPerFrameAvg;
+    float transactionsPerFrameAvg;
+    float marginPerFrameAvg;
+    uint32_t diff1Computed;
+    uint32_t diff1Overflow;
+    float diff1SizeAvg;
+    float diff1TimeAvgUs;
+    uint32_t diff2Computed;
+    uint32_t diff2Overflow;
+    float diff2SizeAvg;
+    float diff2TimeAvgUs;
+    uint32_t flushes;
+    float bytesPerFrame;
+    float flushTimeAvgUs;
+    uint32_t flushTimeMaxUs;
+    uint32_t batchCommits;
+    uint32_t batchRegions;
+    uint32_t tuneAdjustments;
+    uint16_t diffGap;
+    uint16_t vsyncSpacing;
+    float lateStartRatio;
+};
+
+/// UsbMidi output queue stats, one window
+struct __attribute__((packed)) TelemetryMidiOutput {
+    static constexpr TelemetryType TYPE = TelemetryType::MIDI_OUTPUT;
+    static constexpr uint8_t VERSION = 1;
+
+    TelemetryHeader header;
+    uint32_t windowMs;
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t dropped;
+    uint32_t coalesced;
+    uint32_t maxDepth;
+    uint32_t drains;
+    uint32_t maxPacketsPerDrain;
+    uint32_t maxDrainUs;
+    uint32_t sysExBytesSent;
+    uint32_t sysExBytesPending;
+    uint32_t sysExDropped;
+    uint32_t scheduledSent;
+    uint32_t scheduledDropped;
+    uint32_t maxLateUs;
+    uint32_t realtimeSent;
+    uint32_t realtimeDropped;
+    uint32_t maxRealtimeLatencyUs;
+};
+
+static_assert(sizeof(TelemetryHeader) == 10, "TelemetryHeader layout is part of the wire format");
+static_assert(sizeof(TelemetryDisplayPerf) == 10 + 32 * 4, "TelemetryDisplayPerf layout changed: bump VERSION");
+static_assert(sizeof(TelemetryMidiOutput) == 10 + 18 * 4, "TelemetryMidiOutput layout changed: bump VERSION");
+
+/**
+ * @brief Rate-limited sink for telemetry records
+ *
+ * Each record type has its own cadence slot, so sources never need to
+ * coordinate. Not thread-safe: call from the main loop.
+ */
+class TelemetryChannel {
+public:
+    explicit TelemetryChannel(interface::ITransport& transport, uint32_t intervalMs = 1000)
+        : transport_(&transport), interval_ms_(intervalMs) {}
+
+    uint32_t intervalMs() const { return interval_ms_; }
+    void setIntervalMs(uint32_t intervalMs) { interval_ms_ = intervalMs; }
+
+    /// True when a record of this type is due; arms the next slot
+    bool due(TelemetryType type, uint32_t nowMs) {
+        uint32_t& last = last_sent_ms_[static_cast<size_t>(type)];
+        if (last != 0 && (nowMs - last) < interval_ms_) return false;
+        last = (nowMs == 0) ? 1 : nowMs;
+        return true;
+    }
+
+    /// Stamp the header and send the record as one frame
+    template <typename Record>
+    void send(Record& record, uint32_t nowMs) {
+        record.header = {};
+        record.header.type = static_cast<uint8_t>(Record::TYPE);
+        record.header.version = Record::VERSION;
+        record.header.size = static_cast<uint16_t>(sizeof(Record));
+        record.header.timestampMs = nowMs;
+        transport_->send(reinterpret_cast<const uint8_t*>(&record), sizeof(Record));
+        ++records_sent_;
+    }
+
+    uint32_t recordsSent() const { return records_sent_; }
+
+private:
+    interface::ITransport* transport_;
+    uint32_t interval_ms_;
+    std::array<uint32_t, static_cast<size_t>(TelemetryType::COUNT)> last_sent_ms_{};
+    uint32_t records_sent_ = 0;
+};
+
+}  // namespace oc::hal::teensy
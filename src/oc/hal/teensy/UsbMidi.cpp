@@ -1,6 +1,7 @@
 #include "UsbMidi.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 #include <Arduino.h>
 
@@ -40,19 +41,71 @@ private:
     uint32_t primask_ = 0;
 };
 
+// USB-MIDI 1.0 event packet: byte 0 = cable (high nibble) | CIN (low nibble),
+// bytes 1-3 = MIDI bytes. Packed little-endian as usb_midi_write_packed expects.
+constexpr uint32_t CIN_MASK = 0x0000000FU;
+constexpr uint32_t CIN_DEFERRED = 0x0U;  // Reserved CIN, never sent
+constexpr uint32_t CIN_SYSEX_CONTINUE = 0x4U;
+constexpr uint32_t CIN_SYSEX_END_1 = 0x5U;  // 0x6 / 0x7 end with 2 / 3 bytes
+constexpr uint32_t CIN_SINGLE_BYTE = 0xFU;
+
+constexpr uint32_t SYSEX_MARKER = CIN_DEFERRED | (0xF0U << 8);
+
+constexpr uint32_t packChannelMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    return static_cast<uint32_t>(status >> 4) |
+           (static_cast<uint32_t>(status) << 8) |
+           (static_cast<uint32_t>(data1 & 0x7F) << 16) |
+           (static_cast<uint32_t>(data2 & 0x7F) << 24);
+}
+
+constexpr uint32_t packChannelMessage(uint8_t type, uint8_t channel, uint8_t data1, uint8_t data2) {
+    return packChannelMessage(static_cast<uint8_t>(type | (channel & 0x0F)), data1, data2);
+}
+
+constexpr uint32_t packRealtime(uint8_t status) {
+    return CIN_SINGLE_BYTE | (static_cast<uint32_t>(status) << 8);
+}
+
+constexpr uint32_t packPitchBend(uint8_t channel, int16_t value) {
+    const int32_t clamped = value < -8192 ? -8192 : (value > 8191 ? 8191 : value);
+    const uint32_t bend = static_cast<uint32_t>(clamped + 8192);
+    return packChannelMessage(0xE0, channel, bend & 0x7F, (bend >> 7) & 0x7F);
+}
+
+constexpr uint8_t packetStatus(uint32_t packet) { return static_cast<uint8_t>(packet >> 8); }
+constexpr uint8_t packetData1(uint32_t packet) { return static_cast<uint8_t>(packet >> 16); }
+constexpr uint8_t packetData2(uint32_t packet) { return static_cast<uint8_t>(packet >> 24); }
+
+constexpr uint32_t asCoalescedMarker(uint32_t packet) {
+    return (packet & ~CIN_MASK) | CIN_DEFERRED;
+}
+
 }  // namespace
 
 FLASHMEM UsbMidi::UsbMidi(const UsbMidiConfig& config)
-    : max_active_notes_(config.maxActiveNotes) {}
+    : defer_input_(config.deferInputDispatch),
+      coalesce_input_cc_(config.deferInputDispatch && config.coalesceInputCC),
+      clock_follower_(config.clockFollower),
+      coalesce_controllers_(config.coalesceControllers),
+      immediate_realtime_(config.immediateRealtime),
+      sysex_pool_bytes_(config.sysExPoolBytes) {}
 
 FLASHMEM oc::type::Result<void> UsbMidi::init() {
     if (initialized_) return oc::type::Result<void>::ok();
 
-    active_notes_.resize(max_active_notes_);
-    for (auto& note : active_notes_) {
-        note.active = false;
+    active_notes_ = {};
+
+    if (coalesce_controllers_ && !coalesce_) {
+        coalesce_ = std::make_unique<CoalesceTable>();
     }
 
+    if (coalesce_input_cc_ && !input_cc_slots_) {
+        input_cc_slots_ = std::make_unique<std::array<uint8_t, 16 * 128>>();
+    }
+
+    sysex_pool_.resize(sysex_pool_bytes_);
+    sysex_arena_.reset(sysex_pool_.data(), sysex_pool_.size());
+
     initialized_ = true;
     return oc::type::Result<void>::ok();
 }
@@ -67,48 +120,95 @@ void UsbMidi::update() {
 void UsbMidi::pollInput() {
     if (!initialized_) return;
 
-    while (usbMIDI.read()) {
-        const uint64_t timestampUs = nowUs_();
-        uint8_t type = usbMIDI.getType();
-        uint8_t channel = usbMIDI.getChannel() - 1;
-        uint8_t data1 = usbMIDI.getData1();
-        uint8_t data2 = usbMIDI.getData2();
-
-        switch (type) {
-            case usbMIDI.ControlChange:
-                if (on_cc_) on_cc_(channel, data1, data2);
-                break;
-            case usbMIDI.NoteOn:
-                if (on_note_on_) on_note_on_(channel, data1, data2);
-                break;
-            case usbMIDI.NoteOff:
-                if (on_note_off_) on_note_off_(channel, data1, data2);
-                break;
-            case usbMIDI.SystemExclusive:
-                if (on_sysex_) {
-                    on_sysex_(usbMIDI.getSysExArray(), usbMIDI.getSysExArrayLength());
-                }
-                break;
-            case usbMIDI.Clock:
-                if (on_clock_) on_clock_(timestampUs);
-                break;
-            case usbMIDI.Start:
-                if (on_start_) on_start_();
-                break;
-            case usbMIDI.Continue:
-                if (on_continue_) on_continue_();
-                break;
-            case usbMIDI.Stop:
-                if (on_stop_) on_stop_();
-                break;
-            default:
-                break;
+    // Deferred mode stops reading once the ring is full; the rest waits in the
+    // USB buffer rather than being dropped.
+    while ((!defer_input_ || inputEventsPending() < INPUT_QUEUE_CAPACITY) && usbMIDI.read()) {
+        InputEvent event;
+        event.timestampUs = nowUs_();
+        event.type = usbMIDI.getType();
+        event.channel = usbMIDI.getChannel() - 1;
+        event.data1 = usbMIDI.getData1();
+        event.data2 = usbMIDI.getData2();
+
+        if (event.type == usbMIDI.Clock) {
+            clock_follower_.onTick(event.timestampUs);
+        } else if (event.type == usbMIDI.Start) {
+            clock_follower_.onStart();
+        }
+
+        if (event.type == usbMIDI.SystemExclusive) {
+            // The SysEx buffer is reused by the next read, so it cannot wait
+            if (defer_input_) dispatchInput(UINT32_MAX);
+            if (on_sysex_) {
+                on_sysex_(usbMIDI.getSysExArray(), usbMIDI.getSysExArrayLength());
+            }
+        } else if (defer_input_) {
+            queueInputEvent_(event);
+        } else {
+            dispatchInputEvent_(event);
         }
     }
 
+    if (defer_input_) dispatchInput(DEFAULT_INPUT_DISPATCH_BUDGET_US);
     maybeLogOutputQueueStats_();
 }
 
+void UsbMidi::dispatchInput(uint32_t budgetUs) {
+    if (!initialized_ || input_head_ == input_tail_) return;
+
+    const uint32_t startUs = static_cast<uint32_t>(nowUs_());
+    do {
+        const InputEvent event = input_events_[input_head_ % INPUT_QUEUE_CAPACITY];
+        if (input_cc_slots_ && event.type == usbMIDI.ControlChange) {
+            (*input_cc_slots_)[((event.channel & 0x0F) << 7) | (event.data1 & 0x7F)] = 0;
+        }
+        ++input_head_;
+        dispatchInputEvent_(event);
+    } while (input_head_ != input_tail_ &&
+             (static_cast<uint32_t>(nowUs_()) - startUs) < budgetUs);
+}
+
+void UsbMidi::queueInputEvent_(const InputEvent& event) {
+    if (input_cc_slots_ && event.type == usbMIDI.ControlChange) {
+        uint8_t& slot = (*input_cc_slots_)[((event.channel & 0x0F) << 7) | (event.data1 & 0x7F)];
+        if (slot != 0) {
+            input_events_[slot - 1U] = event;  // Still queued: latest value wins
+            return;
+        }
+        slot = static_cast<uint8_t>((input_tail_ % INPUT_QUEUE_CAPACITY) + 1U);
+    }
+    input_events_[input_tail_ % INPUT_QUEUE_CAPACITY] = event;
+    ++input_tail_;
+}
+
+void UsbMidi::dispatchInputEvent_(const InputEvent& event) {
+    switch (event.type) {
+        case usbMIDI.ControlChange:
+            if (on_cc_) on_cc_(event.channel, event.data1, event.data2);
+            break;
+        case usbMIDI.NoteOn:
+            if (on_note_on_) on_note_on_(event.channel, event.data1, event.data2);
+            break;
+        case usbMIDI.NoteOff:
+            if (on_note_off_) on_note_off_(event.channel, event.data1, event.data2);
+            break;
+        case usbMIDI.Clock:
+            if (on_clock_) on_clock_(event.timestampUs);
+            break;
+        case usbMIDI.Start:
+            if (on_start_) on_start_();
+            break;
+        case usbMIDI.Continue:
+            if (on_continue_) on_continue_();
+            break;
+        case usbMIDI.Stop:
+            if (on_stop_) on_stop_();
+            break;
+        default:
+            break;
+    }
+}
+
 void UsbMidi::serviceOutput() {
     serviceOutput(DEFAULT_OUTPUT_DRAIN_BUDGET_US);
 }
@@ -122,242 +222,627 @@ void UsbMidi::serviceOutput(uint32_t budgetUs) {
 }
 
 void UsbMidi::markNoteActive(uint8_t channel, uint8_t note) {
-    for (auto& slot : active_notes_) {
-        if (!slot.active) {
-            slot = {channel, note, true};
-            return;
-        }
-    }
-    if (!active_notes_.empty()) {
-        active_notes_[0] = {channel, note, true};
+    channel &= 0x0F;
+    note &= 0x7F;
+    uint32_t& word = active_notes_.bits[channel][note >> 5];
+    const uint32_t bit = 1U << (note & 31U);
+    if ((word & bit) == 0) {
+        word |= bit;
+        active_notes_.counts[channel] += 1U;
     }
 }
 
 void UsbMidi::markNoteInactive(uint8_t channel, uint8_t note) {
-    for (auto& slot : active_notes_) {
-        if (slot.active && slot.channel == channel && slot.note == note) {
-            slot.active = false;
-            return;
-        }
+    channel &= 0x0F;
+    note &= 0x7F;
+    uint32_t& word = active_notes_.bits[channel][note >> 5];
+    const uint32_t bit = 1U << (note & 31U);
+    if ((word & bit) != 0) {
+        word &= ~bit;
+        active_notes_.counts[channel] -= 1U;
     }
 }
 
 void UsbMidi::sendCC(uint8_t channel, uint8_t cc, uint8_t value) {
-    enqueueShortMessage_(ShortMessageType::ControlChange, channel, cc, value);
+    const EventPacket packet = packChannelMessage(0xB0, channel, cc, value);
+    if (coalesce_) {
+        enqueueCoalesced_(coalesce_->controlChange[((channel & 0x0F) << 7) | (cc & 0x7F)],
+                          static_cast<uint8_t>(value & 0x7F),
+                          CoalesceTable::PENDING_8,
+                          asCoalescedMarker(packet));
+        return;
+    }
+    enqueue_(packet);
 }
 
 void UsbMidi::sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
-    enqueueShortMessage_(ShortMessageType::NoteOn, channel, note, velocity);
+    enqueue_(packChannelMessage(0x90, channel, note, velocity));
 }
 
 void UsbMidi::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
-    enqueueShortMessage_(ShortMessageType::NoteOff, channel, note, velocity);
+    enqueue_(packChannelMessage(0x80, channel, note, velocity));
 }
 
 void UsbMidi::sendSysEx(const uint8_t* data, size_t length) {
-    usbMIDI.sendSysEx(length, data, true);
+    sendSysEx(data, length, false);
+}
+
+bool UsbMidi::sendSysEx(const uint8_t* data, size_t length, bool dataStaysValid) {
+    if (dataStaysValid) return sendSysExNoCopy(data, length);
+    if (!initialized_ || data == nullptr || length == 0) return false;
+
+    // Never drain from here: a full queue is backpressure, reported as a drop.
+    // The SysEx queue has a single (thread-mode) producer.
+    const bool hasRoom = readIpsr() == 0U &&
+                         sysex_jobs_.size() < SYSEX_QUEUE_CAPACITY &&
+                         thread_lane_.ring.size() < OUTPUT_QUEUE_CAPACITY;
+    uint32_t offset = 0;
+    uint8_t* copy = hasRoom ? sysex_arena_.allocate(length, offset) : nullptr;
+    if (copy == nullptr) {
+        sysex_dropped_total_.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::memcpy(copy, data, length);
+    return queueSysEx_({
+        .data = copy,
+        .length = static_cast<uint32_t>(length),
+        .poolOffset = offset,
+        .pooled = true,
+    });
+}
+
+bool UsbMidi::sendSysExNoCopy(const uint8_t* data, size_t length) {
+    if (!initialized_ || data == nullptr || length == 0) return false;
+
+    if (readIpsr() != 0U || sysex_jobs_.size() >= SYSEX_QUEUE_CAPACITY ||
+        thread_lane_.ring.size() >= OUTPUT_QUEUE_CAPACITY) {
+        sysex_dropped_total_.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    return queueSysEx_({
+        .data = data,
+        .length = static_cast<uint32_t>(length),
+    });
+}
+
+size_t UsbMidi::sysExBytesPending() const {
+    return sysex_bytes_pending_.load(std::memory_order_relaxed);
 }
 
 void UsbMidi::sendProgramChange(uint8_t channel, uint8_t program) {
-    enqueueShortMessage_(ShortMessageType::ProgramChange, channel, program, 0);
+    enqueue_(packChannelMessage(0xC0, channel, program, 0));
 }
 
 void UsbMidi::sendPitchBend(uint8_t channel, int16_t value) {
-    enqueuePitchBend_(channel, value);
+    const EventPacket packet = packPitchBend(channel, value);
+    if (coalesce_) {
+        // Stored as the unsigned 14-bit wire value so the top bit stays free
+        const uint16_t bend = static_cast<uint16_t>(packetData1(packet) | (packetData2(packet) << 7));
+        enqueueCoalesced_(coalesce_->pitchBend[channel & 0x0F],
+                          bend,
+                          CoalesceTable::PENDING_16,
+                          asCoalescedMarker(packet));
+        return;
+    }
+    enqueue_(packet);
 }
 
 void UsbMidi::sendChannelPressure(uint8_t channel, uint8_t pressure) {
-    enqueueShortMessage_(ShortMessageType::ChannelPressure, channel, pressure, 0);
+    const EventPacket packet = packChannelMessage(0xD0, channel, pressure, 0);
+    if (coalesce_) {
+        enqueueCoalesced_(coalesce_->channelPressure[channel & 0x0F],
+                          static_cast<uint8_t>(pressure & 0x7F),
+                          CoalesceTable::PENDING_8,
+                          asCoalescedMarker(packet));
+        return;
+    }
+    enqueue_(packet);
 }
 
 void UsbMidi::sendClock() {
-    enqueueShortMessage_(ShortMessageType::Clock, 0, 0, 0);
+    enqueueRealtime_(packRealtime(0xF8));
 }
 
 void UsbMidi::sendStart() {
-    enqueueShortMessage_(ShortMessageType::Start, 0, 0, 0);
+    enqueueRealtime_(packRealtime(0xFA));
 }
 
 void UsbMidi::sendStop() {
-    enqueueShortMessage_(ShortMessageType::Stop, 0, 0, 0);
+    enqueueRealtime_(packRealtime(0xFC));
 }
 
 void UsbMidi::sendContinue() {
-    enqueueShortMessage_(ShortMessageType::Continue, 0, 0, 0);
+    enqueueRealtime_(packRealtime(0xFB));
 }
 
 void UsbMidi::allNotesOff() {
     clearOutputQueue_();
 
-    for (auto& slot : active_notes_) {
-        if (slot.active) {
-            usbMIDI.sendNoteOff(slot.note, 0, slot.channel + 1);
-            slot.active = false;
+    for (uint8_t channel = 0; channel < active_notes_.bits.size(); ++channel) {
+        if (active_notes_.counts[channel] == 0) continue;
+
+        auto& words = active_notes_.bits[channel];
+        for (uint8_t w = 0; w < words.size(); ++w) {
+            uint32_t pending = words[w];
+            while (pending != 0) {
+                const uint8_t note = static_cast<uint8_t>((w << 5) | __builtin_ctz(pending));
+                usb_midi_write_packed(packChannelMessage(0x80, channel, note, 0));
+                pending &= pending - 1U;
+            }
+            words[w] = 0;
         }
+        active_notes_.counts[channel] = 0;
     }
 
-    usbMIDI.send_now();
+    usb_midi_flush_output();
+}
+
+bool UsbMidi::scheduleNoteOn(uint64_t dueUs, uint8_t channel, uint8_t note, uint8_t velocity) {
+    return schedule_(dueUs, packChannelMessage(0x90, channel, note, velocity));
+}
+
+bool UsbMidi::scheduleNoteOff(uint64_t dueUs, uint8_t channel, uint8_t note, uint8_t velocity) {
+    return schedule_(dueUs, packChannelMessage(0x80, channel, note, velocity));
+}
+
+bool UsbMidi::scheduleCC(uint64_t dueUs, uint8_t channel, uint8_t cc, uint8_t value) {
+    return schedule_(dueUs, packChannelMessage(0xB0, channel, cc, value));
+}
+
+bool UsbMidi::schedulePitchBend(uint64_t dueUs, uint8_t channel, int16_t value) {
+    return schedule_(dueUs, packPitchBend(channel, value));
+}
+
+bool UsbMidi::scheduleClock(uint64_t dueUs) {
+    return schedule_(dueUs, packRealtime(0xF8));
 }
 
 uint64_t UsbMidi::nowUs_() {
     return clock_.micros64();
 }
 
-bool UsbMidi::enqueueShortMessage_(ShortMessageType type,
-                                   uint8_t channel,
-                                   uint8_t data1,
-                                   uint8_t data2) {
+bool UsbMidi::enqueue_(EventPacket packet) {
     if (!initialized_) {
         return false;
     }
 
-    InterruptLock lock;
-    if (output_queue_count_ >= output_queue_.size()) {
-        output_stats_.droppedCount += 1U;
-        return false;
+    if (readIpsr() != 0U) {
+        // Handlers of different priorities can nest, so the ISR lane is only
+        // single-producer inside this short section. Thread mode never masks.
+        InterruptLock lock;
+        return pushToLane_(isr_lane_, packet);
     }
+    return pushToLane_(thread_lane_, packet);
+}
 
-    output_queue_[output_queue_tail_] = {
-        .type = type,
-        .channel = channel,
-        .data1 = data1,
-        .data2 = data2,
-    };
-    output_queue_tail_ = (output_queue_tail_ + 1U) % output_queue_.size();
-    output_queue_count_ += 1U;
-    output_stats_.enqueuedCount += 1U;
-    output_stats_.maxDepth =
-        std::max(output_stats_.maxDepth, static_cast<uint32_t>(output_queue_count_));
+bool UsbMidi::enqueueRealtime_(EventPacket packet) {
+    if (!initialized_) return false;
+
+    {
+        // Realtime traffic is sparse (24 PPQN), so a short masked push lets
+        // thread mode and every handler share one ring.
+        InterruptLock lock;
+        if (!realtime_ring_.push({packet, HighResolutionClock::cycles()})) {
+            realtime_dropped_total_.fetch_add(1U, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    if (immediate_realtime_ && readIpsr() == 0U &&
+        !draining_.exchange(true, std::memory_order_acquire)) {
+        // Taking the drain claim keeps the realtime lane single-consumer
+        if (drainRealtime_() > 0) usb_midi_flush_output();
+        draining_.store(false, std::memory_order_release);
+    }
     return true;
 }
 
-bool UsbMidi::enqueuePitchBend_(uint8_t channel, int16_t value) {
-    if (!initialized_) {
-        return false;
+uint32_t UsbMidi::drainRealtime_() {
+    // Realtime bytes may be interleaved anywhere, even inside a SysEx stream
+    uint32_t sent = 0;
+    RealtimePacket entry;
+    while (realtime_ring_.pop(entry)) {
+        usb_midi_write_packed(entry.packet);
+        const uint32_t latencyUs =
+            HighResolutionClock::cyclesToMicros(HighResolutionClock::cycles() - entry.queuedCycles);
+        output_stats_.maxRealtimeLatencyUs = std::max(output_stats_.maxRealtimeLatencyUs, latencyUs);
+        ++sent;
     }
+    output_stats_.realtimeSent += sent;
+    return sent;
+}
 
-    InterruptLock lock;
-    if (output_queue_count_ >= output_queue_.size()) {
-        output_stats_.droppedCount += 1U;
+bool UsbMidi::pushToLane_(OutputLane& lane, EventPacket packet) {
+    if (!lane.ring.push(packet)) {
+        lane.droppedTotal.fetch_add(1U, std::memory_order_relaxed);
         return false;
     }
-
-    output_queue_[output_queue_tail_] = {
-        .type = ShortMessageType::PitchBend,
-        .channel = channel,
-        .signedValue = value,
-    };
-    output_queue_tail_ = (output_queue_tail_ + 1U) % output_queue_.size();
-    output_queue_count_ += 1U;
-    output_stats_.enqueuedCount += 1U;
-    output_stats_.maxDepth =
-        std::max(output_stats_.maxDepth, static_cast<uint32_t>(output_queue_count_));
+    lane.enqueuedTotal.fetch_add(1U, std::memory_order_relaxed);
     return true;
 }
 
-bool UsbMidi::tryDequeueShortMessage_(QueuedShortMessage& message) {
-    InterruptLock lock;
-    if (output_queue_count_ == 0) {
+template <typename Value>
+bool UsbMidi::enqueueCoalesced_(std::atomic<Value>& slot,
+                                Value encoded,
+                                Value pendingBit,
+                                EventPacket marker) {
+    if (!initialized_) {
         return false;
     }
 
-    message = output_queue_[output_queue_head_];
-    output_queue_head_ = (output_queue_head_ + 1U) % output_queue_.size();
-    output_queue_count_ -= 1U;
-    return true;
+    const Value previous = slot.exchange(static_cast<Value>(encoded | pendingBit),
+                                         std::memory_order_acq_rel);
+    if ((previous & pendingBit) != 0) {
+        // Already queued: the drain will pick up the value we just stored
+        coalesced_total_.fetch_add(1U, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (enqueue_(marker)) {
+        return true;
+    }
+    // Not queued: clear pending only if the slot still holds our value. A
+    // producer that coalesced in between believes it is queued, so retry the
+    // marker for its value before giving up.
+    Value expected = static_cast<Value>(encoded | pendingBit);
+    while (!slot.compare_exchange_strong(expected,
+                                         static_cast<Value>(expected & ~pendingBit),
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+        if ((expected & pendingBit) == 0) {
+            return false;  // Cleared by a later producer that failed the same way
+        }
+        if (enqueue_(marker)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UsbMidi::resolveCoalesced_(EventPacket& packet) {
+    const uint8_t status = packetStatus(packet);
+    const uint8_t channel = status & 0x0F;
+    uint8_t data1 = packetData1(packet);
+    uint8_t data2 = 0;
+    bool pending = false;
+
+    switch (status & 0xF0) {
+        case 0xB0: {
+            const uint8_t slot = coalesce_->controlChange[(channel << 7) | (data1 & 0x7F)]
+                                     .fetch_and(0x7F, std::memory_order_acq_rel);
+            data2 = slot & 0x7F;
+            pending = (slot & CoalesceTable::PENDING_8) != 0;
+            break;
+        }
+        case 0xE0: {
+            const uint16_t slot = coalesce_->pitchBend[channel].fetch_and(
+                0x3FFF, std::memory_order_acq_rel);
+            data1 = slot & 0x7F;
+            data2 = (slot >> 7) & 0x7F;
+            pending = (slot & CoalesceTable::PENDING_16) != 0;
+            break;
+        }
+        case 0xD0: {
+            const uint8_t slot = coalesce_->channelPressure[channel].fetch_and(
+                0x7F, std::memory_order_acq_rel);
+            data1 = slot & 0x7F;
+            pending = (slot & CoalesceTable::PENDING_8) != 0;
+            break;
+        }
+        default:
+            return false;
+    }
+
+    packet = packChannelMessage(status, data1, data2);
+    return pending;
 }
 
 void UsbMidi::clearOutputQueue_() {
-    InterruptLock lock;
-    output_queue_head_ = 0;
-    output_queue_tail_ = 0;
-    output_queue_count_ = 0;
+    // Clearing is a consumer operation; skip it if another context is draining
+    if (draining_.exchange(true, std::memory_order_acquire)) return;
+    thread_lane_.ring.clear();
+    isr_lane_.ring.clear();
+    staged_index_ = 0;
+    staged_count_ = 0;
+    scheduled_count_ = 0;
+
+    if (active_sysex_.data != nullptr) {
+        // Terminate a half-sent message so the host parser resynchronizes
+        if (active_sysex_sent_ > 0) usb_midi_write_packed(CIN_SYSEX_END_1 | (0xF7U << 8));
+        sysex_bytes_pending_.fetch_sub(active_sysex_.length - active_sysex_sent_,
+                                       std::memory_order_relaxed);
+        finishSysEx_();
+    }
+    SysExJob job;
+    while (sysex_jobs_.pop(job)) {
+        sysex_bytes_pending_.fetch_sub(job.length, std::memory_order_relaxed);
+        if (job.pooled) sysex_arena_.release(job.poolOffset, job.length);
+    }
+
+    if (coalesce_) {
+        // Markers are gone, so drop the pending flags they stood for
+        for (auto& slot : coalesce_->controlChange) slot.store(0, std::memory_order_relaxed);
+        for (auto& slot : coalesce_->pitchBend) slot.store(0, std::memory_order_relaxed);
+        for (auto& slot : coalesce_->channelPressure) slot.store(0, std::memory_order_relaxed);
+    }
+    draining_.store(false, std::memory_order_release);
 }
 
 void UsbMidi::drainOutputQueue_(uint32_t budgetUs) {
-    QueuedShortMessage message;
-    if (!tryDequeueShortMessage_(message)) {
+    // Single consumer: a context that preempts an ongoing drain just returns
+    if (draining_.exchange(true, std::memory_order_acquire)) return;
+
+    // Depth only grows between drains, so sampling it here tracks the peak
+    const size_t depth =
+        thread_lane_.ring.size() + isr_lane_.ring.size() + (staged_count_ - staged_index_);
+    const bool scheduledDue = scheduled_count_ > 0 && scheduled_[0].dueUs <= nowUs_();
+    if (depth == 0 && active_sysex_.data == nullptr && !scheduledDue && realtime_ring_.empty()) {
+        draining_.store(false, std::memory_order_release);
         return;
     }
+    output_stats_.maxDepth = std::max(output_stats_.maxDepth, static_cast<uint32_t>(depth));
 
     const uint32_t drainStartUs = static_cast<uint32_t>(nowUs_());
     uint32_t sentCount = 0;
 
     do {
-        sendShortMessage_(message);
-        sentCount += 1U;
+        if (!realtime_ring_.empty()) sentCount += drainRealtime_();
 
-        if ((static_cast<uint32_t>(nowUs_()) - drainStartUs) >= budgetUs) {
-            break;
+        if (active_sysex_.data != nullptr) {
+            // Everything queued after the SysEx waits until it is fully out
+            sentCount += streamSysEx_(SYSEX_CHUNK_PACKETS);
+            if (active_sysex_.data != nullptr) continue;
         }
-    } while (tryDequeueShortMessage_(message));
 
-    usbMIDI.send_now();
+        if (scheduled_count_ > 0) sentCount += releaseDueScheduled_(nowUs_());
+
+        if (staged_index_ == staged_count_) {
+            staged_count_ = isr_lane_.ring.popBulk(staged_.data(), staged_.size());
+            staged_count_ += thread_lane_.ring.popBulk(staged_.data() + staged_count_,
+                                                       staged_.size() - staged_count_);
+            staged_index_ = 0;
+            if (staged_count_ == 0) break;
+        }
+
+        while (staged_index_ < staged_count_) {
+            EventPacket packet = staged_[staged_index_++];
+            if ((packet & CIN_MASK) == CIN_DEFERRED) {
+                if (packet == SYSEX_MARKER) {
+                    if (sysex_jobs_.pop(active_sysex_)) active_sysex_sent_ = 0;
+                    break;
+                }
+                // A marker whose flag is already clear was flushed by allNotesOff()
+                if (!resolveCoalesced_(packet)) continue;
+            }
+            writePacket_(packet);
+            sentCount += 1U;
+        }
+    } while ((static_cast<uint32_t>(nowUs_()) - drainStartUs) < budgetUs);
+
+    usb_midi_flush_output();
     output_stats_.sentCount += sentCount;
+    output_stats_.drainCount += 1U;
+    output_stats_.maxPacketsPerDrain = std::max(output_stats_.maxPacketsPerDrain, sentCount);
     output_stats_.maxDrainUs = std::max(
         output_stats_.maxDrainUs,
         static_cast<uint32_t>(nowUs_()) - drainStartUs
     );
+    draining_.store(false, std::memory_order_release);
 }
 
-void UsbMidi::sendShortMessage_(const QueuedShortMessage& message) {
-    switch (message.type) {
-        case ShortMessageType::ControlChange:
-            usbMIDI.sendControlChange(message.data1, message.data2, message.channel + 1);
-            break;
-        case ShortMessageType::NoteOn:
-            markNoteActive(message.channel, message.data1);
-            usbMIDI.sendNoteOn(message.data1, message.data2, message.channel + 1);
-            break;
-        case ShortMessageType::NoteOff:
-            markNoteInactive(message.channel, message.data1);
-            usbMIDI.sendNoteOff(message.data1, message.data2, message.channel + 1);
-            break;
-        case ShortMessageType::ProgramChange:
-            usbMIDI.sendProgramChange(message.data1, message.channel + 1);
-            break;
-        case ShortMessageType::PitchBend:
-            usbMIDI.sendPitchBend(message.signedValue, message.channel + 1);
+void UsbMidi::writePacket_(EventPacket packet) {
+    const uint8_t status = packetStatus(packet);
+    switch (status & 0xF0) {
+        case 0x90:
+            markNoteActive(status & 0x0F, packetData1(packet));
             break;
-        case ShortMessageType::ChannelPressure:
-            usbMIDI.sendAfterTouch(message.data1, message.channel + 1);
+        case 0x80:
+            markNoteInactive(status & 0x0F, packetData1(packet));
             break;
-        case ShortMessageType::Clock:
-            usbMIDI.sendRealTime(usbMIDI.Clock);
-            break;
-        case ShortMessageType::Start:
-            usbMIDI.sendRealTime(usbMIDI.Start);
-            break;
-        case ShortMessageType::Stop:
-            usbMIDI.sendRealTime(usbMIDI.Stop);
-            break;
-        case ShortMessageType::Continue:
-            usbMIDI.sendRealTime(usbMIDI.Continue);
+        default:
             break;
     }
+    usb_midi_write_packed(packet);
+}
+
+bool UsbMidi::schedule_(uint64_t dueUs, EventPacket packet) {
+    if (!initialized_) return false;
+
+    // The heap is consumer state: take the drain claim while inserting
+    if (draining_.exchange(true, std::memory_order_acquire)) return false;
+
+    bool queued = false;
+    if (scheduled_count_ < SCHEDULE_CAPACITY) {
+        size_t index = scheduled_count_++;
+        const ScheduledPacket entry = {dueUs, schedule_seq_++, packet};
+        while (index > 0) {
+            const size_t parent = (index - 1U) / 2U;
+            if (!scheduledBefore_(entry, scheduled_[parent])) break;
+            scheduled_[index] = scheduled_[parent];
+            index = parent;
+        }
+        scheduled_[index] = entry;
+        queued = true;
+    } else {
+        output_stats_.scheduledDropped += 1U;
+    }
+
+    draining_.store(false, std::memory_order_release);
+    return queued;
+}
+
+uint32_t UsbMidi::releaseDueScheduled_(uint64_t nowUs) {
+    uint32_t released = 0;
+    while (scheduled_count_ > 0 && scheduled_[0].dueUs <= nowUs) {
+        const ScheduledPacket due = scheduled_[0];
+        const ScheduledPacket last = scheduled_[--scheduled_count_];
+
+        // Sift the last entry down from the root
+        size_t index = 0;
+        for (;;) {
+            size_t child = 2U * index + 1U;
+            if (child >= scheduled_count_) break;
+            if (child + 1U < scheduled_count_ &&
+                scheduledBefore_(scheduled_[child + 1U], scheduled_[child])) {
+                ++child;
+            }
+            if (!scheduledBefore_(scheduled_[child], last)) break;
+            scheduled_[index] = scheduled_[child];
+            index = child;
+        }
+        if (scheduled_count_ > 0) scheduled_[index] = last;
+
+        writePacket_(due.packet);
+        output_stats_.maxLateUs =
+            std::max(output_stats_.maxLateUs, static_cast<uint32_t>(nowUs - due.dueUs));
+        ++released;
+    }
+    output_stats_.scheduledSent += released;
+    return released;
+}
+
+bool UsbMidi::scheduledBefore_(const ScheduledPacket& a, const ScheduledPacket& b) {
+    if (a.dueUs != b.dueUs) return a.dueUs < b.dueUs;
+    return static_cast<int32_t>(a.seq - b.seq) < 0;
+}
+
+bool UsbMidi::queueSysEx_(const SysExJob& job) {
+    // Callers checked for room; only this producer can fill either ring
+    sysex_bytes_pending_.fetch_add(job.length, std::memory_order_relaxed);
+    sysex_jobs_.push(job);
+    return pushToLane_(thread_lane_, SYSEX_MARKER);
+}
+
+uint32_t UsbMidi::streamSysEx_(size_t maxPackets) {
+    const uint8_t* data = active_sysex_.data;
+    const uint32_t length = active_sysex_.length;
+    uint32_t offset = active_sysex_sent_;
+    uint32_t packets = 0;
+
+    while (packets < maxPackets && offset < length) {
+        const uint32_t remaining = length - offset;
+        EventPacket packet = 0;
+        if (remaining > 3U) {
+            packet = CIN_SYSEX_CONTINUE;
+            packet |= static_cast<uint32_t>(data[offset]) << 8;
+            packet |= static_cast<uint32_t>(data[offset + 1]) << 16;
+            packet |= static_cast<uint32_t>(data[offset + 2]) << 24;
+            offset += 3U;
+        } else {
+            packet = CIN_SYSEX_END_1 + (remaining - 1U);
+            for (uint32_t i = 0; i < remaining; ++i) {
+                packet |= static_cast<uint32_t>(data[offset + i]) << (8U * (i + 1U));
+            }
+            offset = length;
+        }
+        usb_midi_write_packed(packet);
+        ++packets;
+    }
+
+    const uint32_t sentBytes = offset - active_sysex_sent_;
+    sysex_bytes_pending_.fetch_sub(sentBytes, std::memory_order_relaxed);
+    output_stats_.sysExBytesSent += sentBytes;
+    active_sysex_sent_ = offset;
+
+    if (offset >= length) finishSysEx_();
+    return packets;
+}
+
+void UsbMidi::finishSysEx_() {
+    if (active_sysex_.pooled) {
+        sysex_arena_.release(active_sysex_.poolOffset, active_sysex_.length);
+    }
+    active_sysex_ = {};
+    active_sysex_sent_ = 0;
+}
+
+UsbMidi::ProducerTotals UsbMidi::producerTotals_() const {
+    return {
+        .enqueued = thread_lane_.enqueuedTotal.load(std::memory_order_relaxed) +
+                    isr_lane_.enqueuedTotal.load(std::memory_order_relaxed),
+        .dropped = thread_lane_.droppedTotal.load(std::memory_order_relaxed) +
+                   isr_lane_.droppedTotal.load(std::memory_order_relaxed),
+        .coalesced = coalesced_total_.load(std::memory_order_relaxed),
+        .sysExDropped = sysex_dropped_total_.load(std::memory_order_relaxed),
+        .realtimeDropped = realtime_dropped_total_.load(std::memory_order_relaxed),
+    };
 }
 
 void UsbMidi::maybeLogOutputQueueStats_() {
     const uint32_t nowMs = millis();
+    const ProducerTotals totals = producerTotals_();
+
     if (output_stats_.windowStartMs == 0) {
-        output_stats_.reset(nowMs);
+        output_stats_.reset(nowMs, totals);
         return;
     }
 
-    if ((nowMs - output_stats_.windowStartMs) < 1000U) {
+    if (telemetry_ ? !telemetry_->due(TelemetryType::MIDI_OUTPUT, nowMs)
+                   : (nowMs - output_stats_.windowStartMs) < 1000U) {
         return;
     }
 
-    if (output_stats_.droppedCount > 0 || output_stats_.maxDepth >= 16U || output_stats_.maxDrainUs >= 1000U) {
-        OC_LOG_INFO("[Perf][UsbMidiOut] enq={} sent={} drop={} maxDepth={} maxDrain={}us",
+    output_stats_.enqueuedCount = totals.enqueued - output_stats_.base.enqueued;
+    output_stats_.droppedCount = totals.dropped - output_stats_.base.dropped;
+    output_stats_.coalescedCount = totals.coalesced - output_stats_.base.coalesced;
+    output_stats_.sysExDropped = totals.sysExDropped - output_stats_.base.sysExDropped;
+    output_stats_.realtimeDropped = totals.realtimeDropped - output_stats_.base.realtimeDropped;
+
+    if (telemetry_) {
+        sendOutputTelemetry_(nowMs);
+    } else if (output_stats_.droppedCount > 0 || output_stats_.sysExDropped > 0 ||
+        output_stats_.scheduledDropped > 0 || output_stats_.maxDepth >= 16U ||
+        output_stats_.maxDrainUs >= 1000U || output_stats_.maxLateUs >= 1000U ||
+        output_stats_.realtimeDropped > 0 || output_stats_.maxRealtimeLatencyUs >= 1000U) {
+        OC_LOG_INFO("[Perf][UsbMidiOut] enq={} sent={} drop={} coalesced={} maxDepth={} "
+                    "drains={} maxPackets={} maxDrain={}us sysexSent={}B sysexPending={}B "
+                    "sysexDrop={} sched={} schedDrop={} maxLate={}us rt={} rtDrop={} "
+                    "maxRtLatency={}us",
                     output_stats_.enqueuedCount,
                     output_stats_.sentCount,
                     output_stats_.droppedCount,
+                    output_stats_.coalescedCount,
                     output_stats_.maxDepth,
-                    output_stats_.maxDrainUs);
+                    output_stats_.drainCount,
+                    output_stats_.maxPacketsPerDrain,
+                    output_stats_.maxDrainUs,
+                    output_stats_.sysExBytesSent,
+                    static_cast<uint32_t>(sysExBytesPending()),
+                    output_stats_.sysExDropped,
+                    output_stats_.scheduledSent,
+                    output_stats_.scheduledDropped,
+                    output_stats_.maxLateUs,
+                    output_stats_.realtimeSent,
+                    output_stats_.realtimeDropped,
+                    output_stats_.maxRealtimeLatencyUs);
     }
 
-    output_stats_.reset(nowMs);
+    output_stats_.reset(nowMs, totals);
+}
+
+void UsbMidi::sendOutputTelemetry_(uint32_t nowMs) {
+    TelemetryMidiOutput record{};
+    record.windowMs = nowMs - output_stats_.windowStartMs;
+    record.enqueued = output_stats_.enqueuedCount;
+    record.sent = output_stats_.sentCount;
+    record.dropped = output_stats_.droppedCount;
+    record.coalesced = output_stats_.coalescedCount;
+    record.maxDepth = output_stats_.maxDepth;
+    record.drains = output_stats_.drainCount;
+    record.maxPacketsPerDrain = output_stats_.maxPacketsPerDrain;
+    record.maxDrainUs = output_stats_.maxDrainUs;
+    record.sysExBytesSent = output_stats_.sysExBytesSent;
+    record.sysExBytesPending = static_cast<uint32_t>(sysExBytesPending());
+    record.sysExDropped = output_stats_.sysExDropped;
+    record.scheduledSent = output_stats_.scheduledSent;
+    record.scheduledDropped = output_stats_.scheduledDropped;
+    record.maxLateUs = output_stats_.maxLateUs;
+    record.realtimeSent = output_stats_.realtimeSent;
+    record.realtimeDropped = output_stats_.realtimeDropped;
+    record.maxRealtimeLatencyUs = output_stats_.maxRealtimeLatencyUs;
+    telemetry_->send(record, nowMs);
 }
 
 FLASHMEM void UsbMidi::setOnCC(CCCallback cb) { on_cc_ = cb; }
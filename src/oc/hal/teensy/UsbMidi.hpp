@@ -3,27 +3,79 @@
 #include <cstddef>
 #include <cstdint>
 #include <array>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include <oc/type/Result.hpp>
 #include <oc/interface/IMidi.hpp>
 
 #include "HighResolutionClock.hpp"
+#include "MidiClockFollower.hpp"
+#include "SpscByteArena.hpp"
+#include "SpscRing.hpp"
+#include "Telemetry.hpp"
 
 namespace oc::hal::teensy {
 
 struct UsbMidiConfig {
+    /// Unused: active notes live in a fixed 16x128 bitmap. Kept for source compatibility.
     size_t maxActiveNotes = 32;
+    /**
+     * Latest-value-wins for CC, pitch bend and channel pressure: a new value for
+     * a (channel, controller) that is still queued replaces it in place and goes
+     * out at the queue position of the first one. Notes, program changes and
+     * transport keep strict FIFO order. Costs ~2 KB allocated in init().
+     */
+    bool coalesceControllers = false;
+    /**
+     * Copy pool for queued SysEx (sendSysEx). Messages are streamed in chunks by
+     * serviceOutput() in order with short messages. The default holds a 4 KB
+     * patch dump while another message is still streaming. Messages that do
+     * not fit, or arrive while the queue is full, are dropped and counted in
+     * sysExDropped; queue buffers that stay alive with sendSysExNoCopy()
+     * instead. 0 disables the copy path.
+     */
+    size_t sysExPoolBytes = 8192;
+    /**
+     * Decode incoming packets into a timestamped ring and run the callbacks
+     * afterwards within a time budget, so slow handlers never delay reading the
+     * USB buffer (or skew the clock timestamps). SysEx is still delivered in
+     * place, after the events queued before it.
+     */
+    bool deferInputDispatch = false;
+    /// With deferInputDispatch: a CC still queued for the same (channel, cc) is updated in place
+    bool coalesceInputCC = false;
+    /**
+     * Realtime messages (clock, start, stop, continue) always use their own
+     * lane, drained ahead of everything else. With this set, a realtime send
+     * from thread mode also writes it to USB right away instead of waiting for
+     * the next serviceOutput(), unless a drain is in progress.
+     */
+    bool immediateRealtime = false;
+    /// Filter settings for the incoming clock follower (see clockFollower())
+    MidiClockFollowerConfig clockFollower{};
 };
 
 /**
  * @brief Teensy USB MIDI driver
+ *
+ * Outgoing short messages are queued in lock-free SPSC lanes (one for thread
+ * mode, one for interrupt handlers) and drained by serviceOutput(), so senders
+ * never mask interrupts on the hot path. Realtime messages have their own
+ * small lane that is drained first, so a CC backlog never delays a clock tick.
  */
 class UsbMidi : public interface::IMidi {
 public:
     static constexpr size_t DEFAULT_MAX_ACTIVE_NOTES = 32;
-    static constexpr size_t OUTPUT_QUEUE_CAPACITY = 128;
+    static constexpr size_t OUTPUT_QUEUE_CAPACITY = 128;  ///< Per lane, power of two
     static constexpr uint32_t DEFAULT_OUTPUT_DRAIN_BUDGET_US = 500;
+    static constexpr size_t DEFAULT_SYSEX_POOL_BYTES = 1024;
+    static constexpr size_t SYSEX_QUEUE_CAPACITY = 8;  ///< Queued SysEx messages
+    static constexpr size_t INPUT_QUEUE_CAPACITY = 64;  ///< Deferred input events
+    static constexpr uint32_t DEFAULT_INPUT_DISPATCH_BUDGET_US = 500;
+    static constexpr size_t REALTIME_QUEUE_CAPACITY = 16;  ///< Power of two
+    static constexpr size_t SCHEDULE_CAPACITY = 64;  ///< Timestamped messages waiting for their deadline
 
     UsbMidi() = default;
     explicit UsbMidi(const UsbMidiConfig& config);
@@ -41,6 +93,7 @@ public:
     void sendCC(uint8_t channel, uint8_t cc, uint8_t value) override;
     void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) override;
     void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) override;
+    /// sendSysEx(data, length, false); never blocks, see the overload for drops
     void sendSysEx(const uint8_t* data, size_t length) override;
     void sendProgramChange(uint8_t channel, uint8_t program) override;
     void sendPitchBend(uint8_t channel, int16_t value) override;
@@ -51,6 +104,87 @@ public:
     void sendContinue() override;
     void allNotesOff() override;
 
+    /**
+     * @brief Queue a SysEx message without copying it
+     *
+     * The caller guarantees `data` stays valid and unchanged until
+     * sysExBytesPending() drops to 0. Thread mode only.
+     *
+     * @return false if the SysEx queue is full (message dropped)
+     */
+    bool sendSysExNoCopy(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Queue a SysEx message, reporting backpressure
+     *
+     * Copied into the sysExPoolBytes pool, or queued in place when the caller
+     * sets `dataStaysValid` (see sendSysExNoCopy(); use it for dumps larger
+     * than the pool). Never blocks or drains the queue: messages sent from an
+     * interrupt, larger than the pool or sent while the queue is full are
+     * dropped and counted in sysExDropped.
+     *
+     * @return false if the message was dropped
+     */
+    bool sendSysEx(const uint8_t* data, size_t length, bool dataStaysValid);
+
+    /// SysEx bytes queued or partially sent (backpressure indicator)
+    size_t sysExBytesPending() const;
+
+    /**
+     * @brief Run callbacks for deferred input events
+     *
+     * Called by pollInput() with DEFAULT_INPUT_DISPATCH_BUDGET_US; call it
+     * directly to dispatch on a different schedule. At least one event is
+     * dispatched per call. No-op unless deferInputDispatch is set.
+     */
+    void dispatchInput(uint32_t budgetUs);
+
+    /**
+     * @brief Tempo and phase of the incoming MIDI clock
+     *
+     * Fed at decode time from the packet timestamps, before any deferred
+     * dispatch. Use predictedTickUs() to schedule output ahead of the beat.
+     */
+    const MidiClockFollower& clockFollower() const { return clock_follower_; }
+
+    /// Deferred input events decoded but not yet dispatched
+    size_t inputEventsPending() const { return input_tail_ - input_head_; }
+
+    /**
+     * @name Scheduled output
+     *
+     * Queue a message for release by serviceOutput() once micros64() reaches
+     * `dueUs`. Messages with the same deadline keep their scheduling order;
+     * due messages go out ahead of the immediate queue (after a SysEx that is
+     * already streaming). Lateness is bounded by how often serviceOutput()
+     * runs and is reported as maxLate in the queue stats.
+     *
+     * @return false if the schedule is full, or if called while another
+     *         context is draining the output queue
+     */
+    ///@{
+    bool scheduleNoteOn(uint64_t dueUs, uint8_t channel, uint8_t note, uint8_t velocity);
+    bool scheduleNoteOff(uint64_t dueUs, uint8_t channel, uint8_t note, uint8_t velocity);
+    bool scheduleCC(uint64_t dueUs, uint8_t channel, uint8_t cc, uint8_t value);
+    bool schedulePitchBend(uint64_t dueUs, uint8_t channel, int16_t value);
+    bool scheduleClock(uint64_t dueUs);
+    ///@}
+
+    /// Scheduled messages not yet released
+    size_t scheduledPending() const { return scheduled_count_; }
+
+    /// Time base for schedule*() deadlines and input / clock follower timestamps
+    uint64_t micros64() { return nowUs_(); }
+
+    /**
+     * @brief Send output queue stats as binary records instead of log lines
+     *
+     * Each stats window becomes one TelemetryMidiOutput record at the
+     * channel's cadence, whether or not anything crossed a log threshold.
+     * nullptr restores text logging. The channel must outlive this driver.
+     */
+    void setTelemetry(TelemetryChannel* channel) { telemetry_ = channel; }
+
     void setOnCC(CCCallback cb) override;
     void setOnNoteOn(NoteCallback cb) override;
     void setOnNoteOff(NoteCallback cb) override;
@@ -61,6 +195,20 @@ public:
     void setOnContinue(RealtimeCallback cb) override;
 
 private:
+    static constexpr size_t OUTPUT_DRAIN_BATCH = 16;
+
+    static constexpr size_t SYSEX_CHUNK_PACKETS = 16;  ///< 48 SysEx bytes per budget check
+
+    /// Monotonic producer-side counters, summed over all producer contexts
+    struct ProducerTotals {
+        uint32_t enqueued = 0;
+        uint32_t dropped = 0;
+        uint32_t coalesced = 0;
+        uint32_t sysExDropped = 0;
+        uint32_t realtimeDropped = 0;
+    };
+
+    /// Consumer-owned window; producer counts are derived from the totals
     struct OutputQueueStatsWindow {
         uint32_t windowStartMs = 0;
         uint32_t enqueuedCount = 0;
@@ -68,51 +216,130 @@ private:
         uint32_t droppedCount = 0;
         uint32_t maxDepth = 0;
         uint32_t maxDrainUs = 0;
+        uint32_t coalescedCount = 0;
+        uint32_t drainCount = 0;
+        uint32_t maxPacketsPerDrain = 0;
+        uint32_t sysExBytesSent = 0;
+        uint32_t sysExDropped = 0;
+        uint32_t scheduledSent = 0;
+        uint32_t scheduledDropped = 0;
+        uint32_t maxLateUs = 0;
+        uint32_t realtimeSent = 0;
+        uint32_t realtimeDropped = 0;
+        uint32_t maxRealtimeLatencyUs = 0;
+        ProducerTotals base{};
 
-        void reset(uint32_t nowMs) {
+        void reset(uint32_t nowMs, const ProducerTotals& totals) {
             windowStartMs = nowMs;
             enqueuedCount = 0;
             sentCount = 0;
             droppedCount = 0;
             maxDepth = 0;
             maxDrainUs = 0;
+            coalescedCount = 0;
+            drainCount = 0;
+            maxPacketsPerDrain = 0;
+            sysExBytesSent = 0;
+            sysExDropped = 0;
+            scheduledSent = 0;
+            scheduledDropped = 0;
+            maxLateUs = 0;
+            realtimeSent = 0;
+            realtimeDropped = 0;
+            maxRealtimeLatencyUs = 0;
+            base = totals;
         }
     };
 
-    enum class ShortMessageType : uint8_t {
-        ControlChange,
-        NoteOn,
-        NoteOff,
-        ProgramChange,
-        PitchBend,
-        ChannelPressure,
-        Clock,
-        Start,
-        Stop,
-        Continue,
+    /**
+     * Queued messages are stored pre-encoded as 32-bit USB-MIDI event packets
+     * (byte 0 = cable/CIN, then status, data1, data2), so draining is a plain
+     * copy into the USB TX buffer. CIN 0 (reserved by the USB-MIDI spec) marks
+     * a deferred packet: a coalesced controller that gets its value on drain,
+     * or the place of the next queued SysEx in the stream.
+     */
+    using EventPacket = uint32_t;
+
+    /**
+     * Latest pending value per (channel, controller). The top bit of each slot
+     * marks "queued", so a producer that finds it set only swaps the value and
+     * the drain clears it atomically when it sends.
+     */
+    struct CoalesceTable {
+        static constexpr uint8_t PENDING_8 = 0x80;
+        static constexpr uint16_t PENDING_16 = 0x8000;
+
+        std::array<std::atomic<uint8_t>, 16 * 128> controlChange{};
+        std::array<std::atomic<uint16_t>, 16> pitchBend{};
+        std::array<std::atomic<uint8_t>, 16> channelPressure{};
+    };
+
+    /// One producer context feeding the drain; totals are only written by that producer
+    struct OutputLane {
+        SpscRing<EventPacket, OUTPUT_QUEUE_CAPACITY> ring;
+        std::atomic<uint32_t> enqueuedTotal{0};
+        std::atomic<uint32_t> droppedTotal{0};
+    };
+
+    struct SysExJob {
+        const uint8_t* data = nullptr;
+        uint32_t length = 0;
+        uint32_t poolOffset = 0;
+        bool pooled = false;
+    };
+
+    /// Realtime packet stamped with the cycle counter at send time
+    struct RealtimePacket {
+        EventPacket packet = 0;
+        uint32_t queuedCycles = 0;
+    };
+
+    /// Heap entry ordered by (dueUs, seq)
+    struct ScheduledPacket {
+        uint64_t dueUs = 0;
+        uint32_t seq = 0;
+        EventPacket packet = 0;
     };
 
-    struct QueuedShortMessage {
-        ShortMessageType type = ShortMessageType::Clock;
+    /// Incoming message captured at decode time
+    struct InputEvent {
+        uint64_t timestampUs = 0;
+        uint8_t type = 0;
         uint8_t channel = 0;
         uint8_t data1 = 0;
         uint8_t data2 = 0;
-        int16_t signedValue = 0;
     };
 
-    struct ActiveNote {
-        uint8_t channel;
-        uint8_t note;
-        bool active;
+    /// Notes sent on and not yet off: 16x128 bits plus per-channel counts, no heap
+    struct ActiveNoteSet {
+        std::array<std::array<uint32_t, 4>, 16> bits{};
+        std::array<uint8_t, 16> counts{};
     };
 
-    bool enqueueShortMessage_(ShortMessageType type, uint8_t channel, uint8_t data1, uint8_t data2);
-    bool enqueuePitchBend_(uint8_t channel, int16_t value);
-    bool tryDequeueShortMessage_(QueuedShortMessage& message);
+    bool enqueue_(EventPacket packet);
+    bool enqueueRealtime_(EventPacket packet);
+    uint32_t drainRealtime_();
+    static bool pushToLane_(OutputLane& lane, EventPacket packet);
+    template <typename Value>
+    bool enqueueCoalesced_(std::atomic<Value>& slot,
+                           Value encoded,
+                           Value pendingBit,
+                           EventPacket marker);
+    bool resolveCoalesced_(EventPacket& packet);
     void clearOutputQueue_();
     void drainOutputQueue_(uint32_t budgetUs);
-    void sendShortMessage_(const QueuedShortMessage& message);
+    void writePacket_(EventPacket packet);
+    bool schedule_(uint64_t dueUs, EventPacket packet);
+    uint32_t releaseDueScheduled_(uint64_t nowUs);
+    static bool scheduledBefore_(const ScheduledPacket& a, const ScheduledPacket& b);
+    bool queueSysEx_(const SysExJob& job);
+    uint32_t streamSysEx_(size_t maxPackets);
+    void finishSysEx_();
+    ProducerTotals producerTotals_() const;
+    void queueInputEvent_(const InputEvent& event);
+    void dispatchInputEvent_(const InputEvent& event);
     void maybeLogOutputQueueStats_();
+    void sendOutputTelemetry_(uint32_t nowMs);
     void markNoteActive(uint8_t channel, uint8_t note);
     void markNoteInactive(uint8_t channel, uint8_t note);
     uint64_t nowUs_();
@@ -126,13 +353,39 @@ private:
     RealtimeCallback on_stop_;
     RealtimeCallback on_continue_;
 
-    std::vector<ActiveNote> active_notes_;
-    std::array<QueuedShortMessage, OUTPUT_QUEUE_CAPACITY> output_queue_{};
-    size_t output_queue_head_ = 0;
-    size_t output_queue_tail_ = 0;
-    size_t output_queue_count_ = 0;
+    ActiveNoteSet active_notes_{};
+    std::array<InputEvent, INPUT_QUEUE_CAPACITY> input_events_{};
+    uint32_t input_head_ = 0;
+    uint32_t input_tail_ = 0;
+    std::unique_ptr<std::array<uint8_t, 16 * 128>> input_cc_slots_;  // Slot + 1, 0 = none
+    bool defer_input_ = false;
+    bool coalesce_input_cc_ = false;
+    MidiClockFollower clock_follower_{};
+    OutputLane thread_lane_{};
+    OutputLane isr_lane_{};
+    SpscRing<RealtimePacket, REALTIME_QUEUE_CAPACITY> realtime_ring_;
+    std::atomic<uint32_t> realtime_dropped_total_{0};
+    std::atomic<bool> draining_{false};
+    std::atomic<uint32_t> coalesced_total_{0};
+    std::array<EventPacket, OUTPUT_DRAIN_BATCH> staged_{};  // Popped, not yet sent
+    size_t staged_index_ = 0;
+    size_t staged_count_ = 0;
+    std::array<ScheduledPacket, SCHEDULE_CAPACITY> scheduled_{};  // Binary min-heap
+    size_t scheduled_count_ = 0;
+    uint32_t schedule_seq_ = 0;
+    SpscRing<SysExJob, SYSEX_QUEUE_CAPACITY> sysex_jobs_;
+    SpscByteArena sysex_arena_;
+    std::vector<uint8_t> sysex_pool_;
+    SysExJob active_sysex_{};
+    uint32_t active_sysex_sent_ = 0;
+    std::atomic<uint32_t> sysex_bytes_pending_{0};
+    std::atomic<uint32_t> sysex_dropped_total_{0};
+    std::unique_ptr<CoalesceTable> coalesce_;
+    bool coalesce_controllers_ = false;
+    bool immediate_realtime_ = false;
+    size_t sysex_pool_bytes_ = DEFAULT_SYSEX_POOL_BYTES;
     OutputQueueStatsWindow output_stats_{};
-    size_t max_active_notes_ = DEFAULT_MAX_ACTIVE_NOTES;
+    TelemetryChannel* telemetry_ = nullptr;
     bool initialized_ = false;
     HighResolutionClock clock_{};
 };
@@ -11,10 +11,18 @@
  *       Baud rate is ignored for USB Serial (always full USB speed).
  */
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <Arduino.h>
 #include <oc/interface/ITransport.hpp>
 #include <oc/codec/CobsCodec.hpp>
 
+#include "HighResolutionClock.hpp"
+#include "SpscByteArena.hpp"
+#include "SpscRing.hpp"
+
 namespace oc::hal::teensy {
 
 /**
@@ -23,6 +31,12 @@ namespace oc::hal::teensy {
 struct UsbSerialConfig {
     /// Maximum frame size (must match bridge)
     size_t maxFrameSize = codec::COBS_MAX_FRAME_SIZE;
+    /// Bytes pulled from the USB buffer per read (one 512-byte high-speed packet by default)
+    size_t rxChunkSize = 512;
+    /// Encoded TX frame pool; raised to fit at least one max-size frame
+    size_t txBufferBytes = 4096;
+    /// Time update() may spend writing queued frames
+    uint32_t txBudgetUs = 200;
 };
 
 /**
@@ -33,9 +47,31 @@ struct UsbSerialConfig {
  */
 class UsbSerial : public interface::ITransport {
 public:
+    static constexpr size_t TX_QUEUE_CAPACITY = 16;  ///< Queued frames, power of two
+
     UsbSerial() = default;
     explicit UsbSerial(const UsbSerialConfig& config)
-        : maxFrameSize_(config.maxFrameSize) {}
+        : maxFrameSize_(config.maxFrameSize),
+          rxChunkSize_(std::max<size_t>(config.rxChunkSize, 4)),
+          txBufferBytes_(config.txBufferBytes),
+          txBudgetUs_(config.txBudgetUs) {}
+
+    /// Receive counters over the last completed one-second window
+    struct RxStats {
+        uint32_t bytes = 0;
+        uint32_t frames = 0;
+        uint32_t reads = 0;      ///< Bulk reads from the USB buffer
+        uint32_t dropped = 0;    ///< Oversized or malformed frames
+    };
+
+    /// Transmit counters over the last completed one-second window
+    struct TxStats {
+        uint32_t enqueued = 0;
+        uint32_t dropped = 0;    ///< Queue or pool full
+        uint32_t bytes = 0;      ///< Encoded bytes handed to Serial
+        uint32_t maxDepth = 0;   ///< Peak frames queued
+        uint32_t maxDrainUs = 0;
+    };
 
     ~UsbSerial() override = default;
 
@@ -49,6 +85,11 @@ public:
      */
     oc::type::Result<void> init() override {
         Serial.begin(0);  // Baud ignored for USB
+        rx_chunk_.resize(rxChunkSize_);
+        rx_frame_.resize(codec::cobsMaxEncodedSize(maxFrameSize_));
+        rx_frame_length_ = 0;
+        tx_pool_.resize(std::max(txBufferBytes_, codec::cobsMaxEncodedSize(maxFrameSize_) + 1U));
+        tx_arena_.reset(tx_pool_.data(), tx_pool_.size());
         initialized_ = true;
         return oc::type::Result<void>::ok();
     }
@@ -56,24 +97,78 @@ public:
     /**
      * @brief Poll for incoming data
      *
-     * Reads available bytes from USB Serial, decodes COBS frames,
-     * and invokes the receive callback for each complete frame.
+     * Drains the USB buffer in bulk reads, splits on the 0x00 delimiter with
+     * a word-at-a-time scan and COBS-decodes each frame in place. A frame
+     * received whole in one read is decoded inside the read chunk; only
+     * frames spanning reads are assembled in the frame buffer first. The
+     * callback's data pointer is valid until it returns.
+     *
+     * Queued frames are written first, within txBudgetUs.
      */
     void update() override {
-        if (!initialized_ || !onReceive_) return;
+        if (!initialized_) return;
 
-        while (Serial.available()) {
-            uint8_t byte = Serial.read();
-            decoder_.feed(byte, [this](const uint8_t* data, size_t len) {
-                onReceive_(data, len);
-            });
-        }
+        serviceOutput(txBudgetUs_);
+        if (onReceive_) receive_();
+        updateWindows_();
+    }
+
+    /**
+     * @brief Write queued frames while the USB TX buffer has room
+     *
+     * Never blocks: stops when Serial has no room left or the budget is spent,
+     * resuming mid-frame on the next call.
+     */
+    void serviceOutput(uint32_t budgetUs) {
+        if (!initialized_) return;
+        if (tx_active_.length == 0 && tx_frames_.empty()) return;
+
+        tx_window_.maxDepth = std::max(tx_window_.maxDepth,
+                                       static_cast<uint32_t>(tx_frames_.size()) +
+                                           (tx_active_.length > 0 ? 1U : 0U));
+        const uint32_t startCycles = HighResolutionClock::cycles();
+        do {
+            if (tx_active_.length == 0 && !tx_frames_.pop(tx_active_)) break;
+
+            const int room = Serial.availableForWrite();
+            if (room <= 0) break;
+
+            const size_t remaining = tx_active_.length - tx_active_sent_;
+            const size_t chunk = std::min(static_cast<size_t>(room), remaining);
+            const size_t written = Serial.write(tx_arena_.data(tx_active_.offset) + tx_active_sent_, chunk);
+            tx_active_sent_ += written;
+            tx_window_.bytes += static_cast<uint32_t>(written);
+
+            if (tx_active_sent_ >= tx_active_.length) {
+                tx_arena_.release(tx_active_.offset, tx_active_.reserved);
+                tx_active_ = {};
+                tx_active_sent_ = 0;
+            } else if (written == 0) {
+                break;
+            }
+        } while (HighResolutionClock::cyclesToMicros(HighResolutionClock::cycles() - startCycles) <
+                 budgetUs);
+
+        tx_window_.maxDrainUs = std::max(
+            tx_window_.maxDrainUs,
+            HighResolutionClock::cyclesToMicros(HighResolutionClock::cycles() - startCycles));
     }
 
+    /// Frames queued or partially written
+    size_t txPending() const { return tx_frames_.size() + (tx_active_.length > 0 ? 1U : 0U); }
+
+    /// Counters of the last completed second
+    TxStats txStats() const { return tx_last_; }
+
+    /// Counters of the last completed second (bytes/s, frames/s)
+    RxStats rxStats() const { return rx_last_; }
+
     /**
-     * @brief Send a framed message
+     * @brief Queue a framed message
      *
-     * COBS-encodes the data and transmits over USB Serial.
+     * COBS-encodes the data once, straight into the TX pool, and returns;
+     * update() / serviceOutput() transmit it. Dropped (and counted) when the
+     * queue or the pool is full.
      *
      * @param data Pointer to message data
      * @param length Number of bytes to send
@@ -82,12 +177,19 @@ public:
         if (!initialized_ || length == 0) return;
         if (length > maxFrameSize_) return;  // Frame too large
 
-        // COBS encode
-        uint8_t encoded[codec::cobsMaxEncodedSize(length)];
-        size_t encodedLen = codec::cobsEncode(data, length, encoded);
+        const size_t reserved = codec::cobsMaxEncodedSize(length);
+        uint32_t offset = 0;
+        uint8_t* encoded = (tx_frames_.size() < TX_QUEUE_CAPACITY)
+            ? tx_arena_.allocate(reserved, offset)
+            : nullptr;
+        if (encoded == nullptr) {
+            tx_window_.dropped += 1;
+            return;
+        }
 
-        // Transmit
-        Serial.write(encoded, encodedLen);
+        const size_t encodedLen = codec::cobsEncode(data, length, encoded);
+        tx_frames_.push({offset, static_cast<uint32_t>(encodedLen), static_cast<uint32_t>(reserved)});
+        tx_window_.enqueued += 1;
     }
 
     /**
@@ -106,9 +208,149 @@ public:
     }
 
 private:
+    static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+    void receive_() {
+        while (true) {
+            const int available = Serial.available();
+            if (available <= 0) break;
+
+            const size_t wanted = std::min(static_cast<size_t>(available), rx_chunk_.size());
+            const size_t count = Serial.readBytes(reinterpret_cast<char*>(rx_chunk_.data()), wanted);
+            if (count == 0) break;
+            rx_window_.reads += 1;
+            rx_window_.bytes += static_cast<uint32_t>(count);
+            consumeChunk_(rx_chunk_.data(), count);
+        }
+    }
+
+    /// Index of the first 0x00 byte, or NOT_FOUND
+    static size_t findDelimiter_(const uint8_t* data, size_t length) {
+        size_t i = 0;
+        for (; i < length && (reinterpret_cast<uintptr_t>(data + i) & 3U) != 0; ++i) {
+            if (data[i] == 0) return i;
+        }
+        for (; i + 4 <= length; i += 4) {
+            uint32_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            // Non-zero iff some byte of word is 0x00
+            if (((word - 0x01010101U) & ~word & 0x80808080U) != 0) break;
+        }
+        for (; i < length; ++i) {
+            if (data[i] == 0) return i;
+        }
+        return NOT_FOUND;
+    }
+
+    /**
+     * COBS-decode a frame (without delimiter) over itself; the output never
+     * overtakes the input. Returns the decoded length, or NOT_FOUND if the
+     * frame is malformed.
+     */
+    static size_t decodeInPlace_(uint8_t* data, size_t length) {
+        size_t read = 0;
+        size_t write = 0;
+        while (read < length) {
+            const uint8_t code = data[read++];
+            if (code == 0 || read + code - 1U > length) return NOT_FOUND;
+            const size_t run = code - 1U;
+            std::memmove(data + write, data + read, run);
+            read += run;
+            write += run;
+            if (code != 0xFF && read < length) data[write++] = 0;
+        }
+        return write;
+    }
+
+    void consumeChunk_(uint8_t* chunk, size_t count) {
+        size_t start = 0;
+        while (start < count) {
+            const size_t found = findDelimiter_(chunk + start, count - start);
+            if (found == NOT_FOUND) {
+                appendPartial_(chunk + start, count - start);
+                return;
+            }
+
+            uint8_t* frame = chunk + start;
+            size_t length = found;
+            if (rx_frame_length_ > 0 || rx_overflow_) {
+                // Tail of a frame that started in an earlier read
+                appendPartial_(frame, length);
+                frame = rx_frame_.data();
+                length = rx_frame_length_;
+            }
+            deliverFrame_(frame, length);
+            rx_frame_length_ = 0;
+            rx_overflow_ = false;
+            start += found + 1U;
+        }
+    }
+
+    void appendPartial_(const uint8_t* data, size_t length) {
+        if (rx_overflow_) return;
+        if (rx_frame_length_ + length > rx_frame_.size()) {
+            rx_overflow_ = true;  // Drop bytes until the next delimiter
+            return;
+        }
+        std::memcpy(rx_frame_.data() + rx_frame_length_, data, length);
+        rx_frame_length_ += length;
+    }
+
+    void deliverFrame_(uint8_t* frame, size_t length) {
+        if (rx_overflow_) {
+            rx_window_.dropped += 1;
+            return;
+        }
+        if (length == 0) return;  // Back-to-back delimiters
+
+        const size_t decoded = decodeInPlace_(frame, length);
+        if (decoded == NOT_FOUND || decoded > maxFrameSize_) {
+            rx_window_.dropped += 1;
+            return;
+        }
+        rx_window_.frames += 1;
+        onReceive_(frame, decoded);
+    }
+
+    void updateWindows_() {
+        const uint32_t nowMs = millis();
+        if (window_start_ms_ == 0) {
+            window_start_ms_ = nowMs;
+        } else if ((nowMs - window_start_ms_) >= 1000U) {
+            rx_last_ = rx_window_;
+            rx_window_ = {};
+            tx_last_ = tx_window_;
+            tx_window_ = {};
+            window_start_ms_ = nowMs;
+        }
+    }
+
+    /// Encoded frame in the TX pool
+    struct TxFrame {
+        uint32_t offset = 0;
+        uint32_t length = 0;     ///< Encoded bytes to write
+        uint32_t reserved = 0;   ///< Bytes allocated in the pool
+    };
+
     ReceiveCallback onReceive_;
-    codec::CobsDecoder<> decoder_;
     size_t maxFrameSize_ = codec::COBS_MAX_FRAME_SIZE;
+    size_t rxChunkSize_ = 512;
+    std::vector<uint8_t> rx_chunk_;
+    std::vector<uint8_t> rx_frame_;     // Frames spanning several reads
+    size_t rx_frame_length_ = 0;
+    bool rx_overflow_ = false;
+    RxStats rx_window_{};
+    RxStats rx_last_{};
+    size_t txBufferBytes_ = 4096;
+    uint32_t txBudgetUs_ = 200;
+    std::vector<uint8_t> tx_pool_;
+    SpscByteArena tx_arena_;
+    SpscRing<TxFrame, TX_QUEUE_CAPACITY> tx_frames_;
+    TxFrame tx_active_{};
+    size_t tx_active_sent_ = 0;
+    TxStats tx_window_{};
+    TxStats tx_last_{};
+    uint32_t window_start_ms_ = 0;
     bool initialized_ = false;
 };
 
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstring>
+#include <functional>
+
+#include <oc/interface/IStorage.hpp>
+#include <oc/type/Result.hpp>
+
+namespace oc::hal::teensy {
+
+/**
+ * @brief Timing policy for WriteCoalescingStorage
+ */
+struct WriteCoalescingConfig {
+    uint32_t quietMs = 500;        ///< Commit once no write happened for this long
+    uint32_t maxLatencyMs = 5000;  ///< Commit at the latest this long after the first pending write
+    bool deferCommit = true;       ///< commit() leaves the flush to update(); sync() always flushes
+};
+
+/**
+ * @brief Commit statistics reported by WriteCoalescingStorage
+ */
+struct WriteCoalescingStats {
+    uint32_t commits = 0;         ///< Flushes to the wrapped backend
+    uint32_t spilledBlocks = 0;   ///< Blocks written through (uncommitted) by a full cache
+    uint32_t coalescedWrites = 0; ///< write()/erase() calls absorbed in RAM
+    uint32_t lastCommitUs = 0;
+    uint32_t maxCommitUs = 0;
+    uint32_t lastCommitBytes = 0;
+};
+
+/**
+ * @brief IStorage decorator that buffers writes in RAM and commits later
+ *
+ * Writes land in a small cache of BlockSize-aligned blocks (read-modify-write
+ * against the wrapped backend on first touch) and reads are overlaid with
+ * pending blocks. update() pushes the dirty blocks to the wrapped backend and
+ * commits it once writes have been quiet for `quietMs`, or `maxLatencyMs`
+ * after the first pending write, so flash programming is not triggered while
+ * controls are being moved. sync() is the explicit flush point (e.g. before
+ * power-down or a preset switch).
+ *
+ * When every cache block is dirty and a write needs another one, the oldest
+ * choice in round-robin order is written through to the wrapped backend
+ * without committing it (counted in `spilledBlocks`), so the commit still
+ * waits for update(). Writes spanning more than BlockCount blocks go straight
+ * to the backend the same way. Size BlockCount for the largest settings burst
+ * expected between commits.
+ *
+ * @code
+ * LittleFSBackend flash;
+ * WriteCoalescingStorage<> storage(flash);
+ * storage.setOnCommit([](uint32_t us, size_t bytes) { ... });
+ * Settings<MySettings> settings(storage, 0x0000, 1);
+ *
+ * void loop() {
+ *     storage.update(millis());
+ * }
+ * @endcode
+ *
+ * @tparam BlockSize Cache block size in bytes
+ * @tparam BlockCount Number of cache blocks
+ */
+template <size_t BlockSize = 64, size_t BlockCount = 16>
+class WriteCoalescingStorage : public interface::IStorage {
+    static_assert(BlockSize > 0 && BlockCount > 0, "WriteCoalescingStorage needs at least one block");
+
+public:
+    /// Called after each flush with its duration (µs) and the bytes written
+    using CommitCallback = std::function<void(uint32_t durationUs, size_t bytes)>;
+
+    explicit WriteCoalescingStorage(interface::IStorage& inner, const WriteCoalescingConfig& config = {})
+        : inner_(inner), config_(config) {}
+
+    oc::type::Result<void> init() override {
+        return inner_.init();
+    }
+
+    bool available() const override {
+        return inner_.available();
+    }
+
+    size_t read(uint32_t address, uint8_t* buffer, size_t size) override {
+        if (inner_.read(address, buffer, size) != size) return 0;
+
+        // Overlay pending blocks on top of what the backend holds
+        const uint32_t end = address + static_cast<uint32_t>(size);
+        for (const Block& block : blocks_) {
+            if (!block.used) continue;
+            const uint32_t blockStart = block.index * BlockSize;
+            const uint32_t blockEnd = blockStart + BlockSize;
+            if (blockEnd <= address || blockStart >= end) continue;
+
+            const uint32_t from = blockStart > address ? blockStart : address;
+            const uint32_t to = blockEnd < end ? blockEnd : end;
+            memcpy(buffer + (from - address), block.data.data() + (from - blockStart), to - from);
+        }
+        return size;
+    }
+
+    size_t write(uint32_t address, const uint8_t* buffer, size_t size) override {
+        if (address + size > inner_.capacity()) return 0;
+        return store_(address, buffer, size);
+    }
+
+    /**
+     * @brief Mark a sync point
+     *
+     * With `deferCommit` the pending blocks stay in RAM until update() decides
+     * to flush; otherwise this behaves like sync().
+     */
+    bool commit() override {
+        if (config_.deferCommit) return true;
+        return sync();
+    }
+
+    bool erase(uint32_t address, size_t size) override {
+        if (address + size > inner_.capacity()) return false;
+        return store_(address, nullptr, size) == size;
+    }
+
+    size_t capacity() const override {
+        return inner_.capacity();
+    }
+
+    bool isDirty() const override {
+        return usedBlocks_ > 0 || inner_.isDirty();
+    }
+
+    /**
+     * @brief Flush when the quiet period or latency bound has elapsed
+     * @param nowMs Current time (millis())
+     * @return true if a flush ran and succeeded
+     */
+    bool update(uint32_t nowMs) {
+        if (!pendingSinceWrite_) return false;
+        const bool quiet = (nowMs - lastWriteMs_) >= config_.quietMs;
+        const bool late = (nowMs - firstWriteMs_) >= config_.maxLatencyMs;
+        if (!quiet && !late) return false;
+        return sync();
+    }
+
+    /// Flush pending blocks and commit the wrapped backend now
+    bool sync() {
+        if (usedBlocks_ == 0 && !inner_.isDirty()) {
+            pendingSinceWrite_ = false;
+            return true;
+        }
+
+        const uint32_t start = micros();
+        size_t bytes = 0;
+        bool ok = true;
+
+        for (Block& block : blocks_) {
+            if (!block.used) continue;
+            if (!spill_(block)) {
+                ok = false;
+                continue;  // Keep the block pending and retry on the next flush
+            }
+            bytes += blockLength_(block.index);
+        }
+        if (usedBlocks_ == 0) pendingSinceWrite_ = false;
+        if (!inner_.commit()) ok = false;
+
+        const uint32_t elapsed = micros() - start;
+        ++stats_.commits;
+        stats_.lastCommitUs = elapsed;
+        stats_.lastCommitBytes = static_cast<uint32_t>(bytes);
+        if (elapsed > stats_.maxCommitUs) stats_.maxCommitUs = elapsed;
+        if (onCommit_) onCommit_(elapsed, bytes);
+        return ok;
+    }
+
+    void setOnCommit(CommitCallback callback) { onCommit_ = std::move(callback); }
+    void setConfig(const WriteCoalescingConfig& config) { config_ = config; }
+    const WriteCoalescingConfig& config() const { return config_; }
+
+    const WriteCoalescingStats& stats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+    /// Number of cache blocks holding uncommitted data
+    size_t pendingBlocks() const { return usedBlocks_; }
+
+private:
+    struct Block {
+        uint32_t index = 0;
+        bool used = false;
+        std::array<uint8_t, BlockSize> data{};
+    };
+
+    /**
+     * @brief Copy data (or 0xFF when nullptr) into the cache
+     *
+     * Every block is acquired before any byte is copied, so a failure leaves
+     * the cache unchanged. Ranges larger than the cache are written through.
+     *
+     * @return Bytes stored: size, or less on failure
+     */
+    size_t store_(uint32_t address, const uint8_t* data, size_t size) {
+        if (size == 0) return 0;
+
+        const uint32_t first = address / BlockSize;
+        const uint32_t last = (address + static_cast<uint32_t>(size) - 1) / BlockSize;
+        size_t stored = 0;
+        if (last - first >= BlockCount) {
+            stored = writeThrough_(address, data, size, first, last);
+        } else {
+            for (uint32_t index = first; index <= last; ++index) {
+                if (!acquire_(index, first, last)) return 0;
+            }
+            stored = size;
+            while (size > 0) {
+                Block* block = find_(address / BlockSize);
+                const uint32_t offset = address % BlockSize;
+                const size_t chunk = (BlockSize - offset < size) ? BlockSize - offset : size;
+                if (data) {
+                    memcpy(block->data.data() + offset, data, chunk);
+                    data += chunk;
+                } else {
+                    memset(block->data.data() + offset, 0xFF, chunk);
+                }
+                address += static_cast<uint32_t>(chunk);
+                size -= chunk;
+            }
+        }
+        if (stored == 0) return 0;
+
+        const uint32_t now = millis();
+        if (!pendingSinceWrite_) {
+            firstWriteMs_ = now;
+            pendingSinceWrite_ = true;
+        }
+        lastWriteMs_ = now;
+        ++stats_.coalescedWrites;
+        return stored;
+    }
+
+    /// Push cached blocks of the range first, then write the range uncommitted
+    size_t writeThrough_(uint32_t address, const uint8_t* data, size_t size,
+                         uint32_t first, uint32_t last) {
+        for (Block& block : blocks_) {
+            if (!block.used || block.index < first || block.index > last) continue;
+            if (!spill_(block)) return 0;
+            ++stats_.spilledBlocks;
+        }
+        if (data) return inner_.write(address, data, size);
+        return inner_.erase(address, size) ? size : 0;
+    }
+
+    Block* find_(uint32_t index) {
+        for (Block& block : blocks_) {
+            if (block.used && block.index == index) return &block;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Find the cache block for index, loading it from the backend on first use
+     *
+     * A full cache spills a block outside [keepFirst, keepLast] to the backend.
+     */
+    Block* acquire_(uint32_t index, uint32_t keepFirst, uint32_t keepLast) {
+        Block* free = nullptr;
+        for (Block& block : blocks_) {
+            if (block.used && block.index == index) return &block;
+            if (!block.used && !free) free = &block;
+        }
+
+        for (size_t n = 0; !free && n < BlockCount; ++n) {
+            Block& victim = blocks_[spillCursor_];
+            spillCursor_ = (spillCursor_ + 1) % BlockCount;
+            if (victim.index >= keepFirst && victim.index <= keepLast) continue;
+            if (!spill_(victim)) return nullptr;
+            ++stats_.spilledBlocks;
+            free = &victim;
+        }
+        if (!free) return nullptr;
+
+        const size_t length = blockLength_(index);
+        free->data.fill(0xFF);
+        if (inner_.read(index * BlockSize, free->data.data(), length) != length) return nullptr;
+
+        free->index = index;
+        free->used = true;
+        ++usedBlocks_;
+        return free;
+    }
+
+    /// Write one block to the backend (no commit) and free it
+    bool spill_(Block& block) {
+        const size_t length = blockLength_(block.index);
+        if (inner_.write(block.index * BlockSize, block.data.data(), length) != length) return false;
+        block.used = false;
+        --usedBlocks_;
+        return true;
+    }
+
+    /// Block length, shortened for the last block of the backend
+    size_t blockLength_(uint32_t index) const {
+        const size_t blockStart = index * BlockSize;
+        const size_t cap = inner_.capacity();
+        return (blockStart + BlockSize <= cap) ? BlockSize : cap - blockStart;
+    }
+
+    interface::IStorage& inner_;
+    WriteCoalescingConfig config_;
+    std::array<Block, BlockCount> blocks_{};
+    size_t usedBlocks_ = 0;
+    size_t spillCursor_ = 0;
+    uint32_t firstWriteMs_ = 0;
+    uint32_t lastWriteMs_ = 0;
+    bool pendingSinceWrite_ = false;
+    WriteCoalescingStats stats_;
+    CommitCallback onCommit_;
+};
+
+}  // namespace oc::hal::teensy
@@ -0,0 +1,84 @@
+/**
+ * @file test_main.cpp
+ * @brief On-target tests for SpscByteArena
+ *
+ * Usage: pio test -e dev -f test_spsc_byte_arena
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include <oc/hal/teensy/SpscByteArena.hpp>
+
+using oc::hal::teensy::SpscByteArena;
+
+namespace {
+
+constexpr size_t CAPACITY = 1024;
+uint8_t storage[CAPACITY];
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_max_block_fits_empty_arena() {
+    SpscByteArena arena(storage, CAPACITY);
+    uint32_t offset = 0;
+    TEST_ASSERT_NOT_NULL(arena.allocate(arena.maxBlockSize(), offset));
+    TEST_ASSERT_EQUAL_UINT32(0, offset);
+    TEST_ASSERT_NULL(arena.allocate(1, offset));
+}
+
+void test_max_block_fits_after_wrap() {
+    SpscByteArena arena(storage, CAPACITY);
+    uint32_t offset = 0;
+
+    // Walk the cursors past the end once, then leave them mid-buffer
+    TEST_ASSERT_NOT_NULL(arena.allocate(700, offset));
+    arena.release(offset, 700);
+    TEST_ASSERT_NOT_NULL(arena.allocate(600, offset));
+    TEST_ASSERT_EQUAL_UINT32(0, offset);
+    arena.release(offset, 600);
+
+    TEST_ASSERT_NOT_NULL(arena.allocate(arena.maxBlockSize(), offset));
+    TEST_ASSERT_EQUAL_UINT32(0, offset);
+    arena.release(offset, arena.maxBlockSize());
+}
+
+void test_mid_buffer_empty_takes_block_larger_than_tail() {
+    SpscByteArena arena(storage, CAPACITY);
+    uint32_t offset = 0;
+    TEST_ASSERT_NOT_NULL(arena.allocate(512, offset));
+    arena.release(offset, 512);
+
+    TEST_ASSERT_NOT_NULL(arena.allocate(600, offset));
+    TEST_ASSERT_NOT_NULL(arena.allocate(300, offset));
+    TEST_ASSERT_EQUAL_UINT32(600, offset);
+}
+
+void test_outstanding_block_is_not_overwritten() {
+    SpscByteArena arena(storage, CAPACITY);
+    uint32_t first = 0;
+    uint32_t second = 0;
+    TEST_ASSERT_NOT_NULL(arena.allocate(512, first));
+    TEST_ASSERT_NOT_NULL(arena.allocate(400, second));
+    arena.release(first, 512);
+
+    uint32_t offset = 0;
+    TEST_ASSERT_NULL(arena.allocate(600, offset));
+    TEST_ASSERT_NOT_NULL(arena.allocate(500, offset));
+    TEST_ASSERT_EQUAL_UINT32(0, offset);
+}
+
+void setup() {
+    delay(2000);  // Let the host open the serial port
+    UNITY_BEGIN();
+    RUN_TEST(test_max_block_fits_empty_arena);
+    RUN_TEST(test_max_block_fits_after_wrap);
+    RUN_TEST(test_mid_buffer_empty_takes_block_larger_than_tail);
+    RUN_TEST(test_outstanding_block_is_not_overwritten);
+    UNITY_END();
+}
+
+void loop() {}
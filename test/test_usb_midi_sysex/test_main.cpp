@@ -0,0 +1,78 @@
+/**
+ * @file test_main.cpp
+ * @brief On-target tests for UsbMidi SysEx queueing and backpressure
+ *
+ * Nothing is drained: every message stays queued, so the pool and the job
+ * ring fill up exactly as they would behind a slow host.
+ *
+ * Usage: pio test -e dev -f test_usb_midi_sysex
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include <array>
+
+#include <oc/hal/teensy/UsbMidi.hpp>
+
+using oc::hal::teensy::UsbMidi;
+using oc::hal::teensy::UsbMidiConfig;
+
+namespace {
+
+constexpr size_t POOL_BYTES = 1024;
+
+std::array<uint8_t, 4096> dump{};
+
+UsbMidiConfig poolConfig() {
+    UsbMidiConfig config;
+    config.sysExPoolBytes = POOL_BYTES;
+    return config;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_copy_is_queued_without_blocking() {
+    UsbMidi midi(poolConfig());
+    TEST_ASSERT_TRUE(static_cast<bool>(midi.init()));
+
+    TEST_ASSERT_TRUE(midi.sendSysEx(dump.data(), 600, false));
+    TEST_ASSERT_EQUAL_UINT32(600, midi.sysExBytesPending());
+}
+
+void test_full_pool_drops_and_reports() {
+    UsbMidi midi(poolConfig());
+    TEST_ASSERT_TRUE(static_cast<bool>(midi.init()));
+
+    TEST_ASSERT_TRUE(midi.sendSysEx(dump.data(), 600, false));
+    TEST_ASSERT_FALSE(midi.sendSysEx(dump.data(), 600, false));
+    TEST_ASSERT_EQUAL_UINT32(600, midi.sysExBytesPending());
+}
+
+void test_oversized_copy_drops_and_no_copy_queues() {
+    UsbMidi midi(poolConfig());
+    TEST_ASSERT_TRUE(static_cast<bool>(midi.init()));
+
+    TEST_ASSERT_FALSE(midi.sendSysEx(dump.data(), dump.size(), false));
+    TEST_ASSERT_EQUAL_UINT32(0, midi.sysExBytesPending());
+
+    TEST_ASSERT_TRUE(midi.sendSysEx(dump.data(), dump.size(), true));
+    TEST_ASSERT_EQUAL_UINT32(dump.size(), midi.sysExBytesPending());
+}
+
+void setup() {
+    delay(2000);  // Let the host open the serial port
+    dump.front() = 0xF0;
+    dump.back() = 0xF7;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_copy_is_queued_without_blocking);
+    RUN_TEST(test_full_pool_drops_and_reports);
+    RUN_TEST(test_oversized_copy_drops_and_no_copy_queues);
+    UNITY_END();
+}
+
+void loop() {}